@@ -0,0 +1,277 @@
+/******************************************************************************
+ * Arquivo: Descritores USB HID (USBdsc.c)
+ * Autor: Elison Nogueira
+ * Data: 18/10/2026
+ * Versão: 1.0
+ * Plataforma: PIC18F25K50 (Microchip)
+ * Compilador: mikroC Pro for PIC v7.6.0
+ *
+ * Descrição:
+ * Descritores de dispositivo, configuração, relatório e strings usados pela
+ * biblioteca USB HID do mikroC. Estrutura gerada a partir do modelo da
+ * ferramenta USB HID Terminal, com o descritor de relatório substituído por
+ * uma coleção de sensores ambientais (HID Sensor Usages, página 0x20).
+ *
+ * Relatórios de entrada (veja usb_sensor.h):
+ * - ID 1: estado (8) + evento (8) + temperatura int16 (°C, exp. -2)
+ * - ID 2: estado (8) + evento (8) + umidade uint16 (%, exp. -2)
+ * - ID 3: estado (8) + evento (8) + pressão uint32 (bar, exp. -5 = Pa)
+ * Todos terminam com o timestamp RTC da amostra (uint32, página vendor): o
+ * tick de 1/4096 s do rtc.h, sem sinal (LOGICAL_MINIMUM 0), que volta a
+ * zero a cada 2^32 ticks (~12 dias); o host compara timestamps pela
+ * diferença módulo 2^32.
+ *
+ * Confira o descritor com os relatórios de usb_sensor.c rodando
+ * python3 usb_descritor.py (tamanho, coleções, IDs e posições dos campos).
+ ******************************************************************************/
+
+#include "bibis/config.h"
+
+#if USE_USB_HID
+
+const unsigned int USB_VENDOR_ID = 0x1234;                                      // Substituir pelo VID definitivo
+const unsigned int USB_PRODUCT_ID = 0x0001;                                     // Substituir pelo PID definitivo
+const char USB_SELF_POWER = 0x80;                                               // 0x80 = alimentado pelo barramento
+const char USB_MAX_POWER = 50;                                                  // Consumo máximo em unidades de 2mA
+const char HID_INPUT_REPORT_BYTES = 64;
+const char HID_OUTPUT_REPORT_BYTES = 64;
+const char USB_TRANSFER_TYPE = 0x03;                                            // 0x03 = interrupção
+const char EP_IN_INTERVAL = 1;                                                  // Polling de 1ms no endpoint IN
+const char EP_OUT_INTERVAL = 1;
+
+const char USB_INTERRUPT = 1;
+const char USB_HID_EP = 1;
+const char USB_HID_RPT_SIZE = 241;
+
+/* Descritor de dispositivo */
+const struct {
+    char bLength;                                                               // Tamanho do descritor (12h)
+    char bDescriptorType;                                                       // DEVICE (01h)
+    unsigned int bcdUSB;                                                        // Versão da especificação USB (BCD)
+    char bDeviceClass;                                                          // Classe definida na interface
+    char bDeviceSubClass;
+    char bDeviceProtocol;
+    char bMaxPacketSize0;                                                       // Tamanho máximo do pacote no EP0
+    unsigned int idVendor;
+    unsigned int idProduct;
+    unsigned int bcdDevice;                                                     // Versão do dispositivo (BCD)
+    char iManufacturer;                                                         // Índice da string do fabricante
+    char iProduct;                                                              // Índice da string do produto
+    char iSerialNumber;                                                         // Sem número de série
+    char bNumConfigurations;
+} device_dsc = {
+      0x12, 0x01, 0x0200, 0x00, 0x00, 0x00, 8, USB_VENDOR_ID, USB_PRODUCT_ID,
+      0x0001, 0x01, 0x02, 0x00, 0x01
+  };
+
+/* Descritor de configuração 1 */
+const char configDescriptor1[]= {
+    // Descritor de configuração
+    0x09,                                                                       // bLength
+    0x02,                                                                       // bDescriptorType = CONFIGURATION
+    0x29,0x00,                                                                  // wTotalLength (41 bytes)
+    1,                                                                          // bNumInterfaces
+    1,                                                                          // bConfigurationValue
+    0,                                                                          // iConfiguration
+    USB_SELF_POWER,                                                             // bmAttributes
+    USB_MAX_POWER,                                                              // bMaxPower
+
+    // Descritor de interface
+    0x09,                                                                       // bLength
+    0x04,                                                                       // bDescriptorType = INTERFACE
+    0,                                                                          // bInterfaceNumber
+    0,                                                                          // bAlternateSetting
+    2,                                                                          // bNumEndpoints
+    0x03,                                                                       // bInterfaceClass = HID
+    0,                                                                          // bInterfaceSubclass = sem boot
+    0,                                                                          // bInterfaceProtocol
+    0,                                                                          // iInterface
+
+    // Descritor de classe HID
+    0x09,                                                                       // bLength
+    0x21,                                                                       // bDescriptorType = HID
+    0x11,0x01,                                                                  // bcdHID = 1.11
+    0x00,                                                                       // bCountryCode
+    1,                                                                          // bNumDescriptors
+    0x22,                                                                       // bDescriptorType = REPORT
+    USB_HID_RPT_SIZE,0x00,                                                      // wDescriptorLength
+
+    // Descritor do endpoint IN
+    0x07,                                                                       // bLength
+    0x05,                                                                       // bDescriptorType = ENDPOINT
+    USB_HID_EP | 0x80,                                                          // bEndpointAddress (IN)
+    USB_TRANSFER_TYPE,                                                          // bmAttributes
+    0x40,0x00,                                                                  // wMaxPacketSize
+    EP_IN_INTERVAL,                                                             // bInterval
+
+    // Descritor do endpoint OUT
+    0x07,                                                                       // bLength
+    0x05,                                                                       // bDescriptorType = ENDPOINT
+    USB_HID_EP,                                                                 // bEndpointAddress (OUT)
+    USB_TRANSFER_TYPE,                                                          // bmAttributes
+    0x40,0x00,                                                                  // wMaxPacketSize
+    EP_OUT_INTERVAL                                                             // bInterval
+};
+
+/* Descritor de relatório: coleção de sensores ambientais */
+const struct {
+  char report[USB_HID_RPT_SIZE];
+}hid_rpt_desc =
+  {
+     {
+       0x05, 0x20,                       // USAGE_PAGE (Sensors)
+       0x09, 0x01,                       // USAGE (Sensor: Collection)
+       0xA1, 0x01,                       // COLLECTION (Application)
+       0x85, 0x01,                       //   REPORT_ID (1)
+       0x09, 0x33,                       //   USAGE (Environmental: Temperature)
+       0xA1, 0x00,                       //   COLLECTION (Physical)
+       0x0A, 0x01, 0x02,                 //     USAGE (Sensor State)
+       0x15, 0x00,                       //     LOGICAL_MINIMUM (0)
+       0x25, 0x06,                       //     LOGICAL_MAXIMUM (6)
+       0x75, 0x08,                       //     REPORT_SIZE (8)
+       0x95, 0x01,                       //     REPORT_COUNT (1)
+       0xA1, 0x02,                       //     COLLECTION (Logical)
+       0x1A, 0x00, 0x08,                 //       USAGE_MINIMUM (Sensor State: Undefined)
+       0x2A, 0x06, 0x08,                 //       USAGE_MAXIMUM (Sensor State: Error)
+       0x81, 0x00,                       //       INPUT (Data,Ary,Abs)
+       0xC0,                             //     END_COLLECTION
+       0x0A, 0x02, 0x02,                 //     USAGE (Sensor Event)
+       0x25, 0x05,                       //     LOGICAL_MAXIMUM (5)
+       0xA1, 0x02,                       //     COLLECTION (Logical)
+       0x1A, 0x10, 0x08,                 //       USAGE_MINIMUM (Sensor Event: Unknown)
+       0x2A, 0x15, 0x08,                 //       USAGE_MAXIMUM (Sensor Event: Change Sensitivity)
+       0x81, 0x00,                       //       INPUT (Data,Ary,Abs)
+       0xC0,                             //     END_COLLECTION
+       0x0A, 0x34, 0x04,                 //     USAGE (Environmental Temperature)
+       0x16, 0x01, 0x80,                 //     LOGICAL_MINIMUM (-32767)
+       0x26, 0xFF, 0x7F,                 //     LOGICAL_MAXIMUM (32767)
+       0x75, 0x10,                       //     REPORT_SIZE (16)
+       0x55, 0x0E,                       //     UNIT_EXPONENT (-2)
+       0x81, 0x02,                       //     INPUT (Data,Var,Abs)
+       0x06, 0x00, 0xFF,                 //     USAGE_PAGE (Vendor Defined)
+       0x09, 0x01,                       //     USAGE (Timestamp RTC, 1/4096 s)
+       0x15, 0x00,                       //     LOGICAL_MINIMUM (0)
+       0x27, 0xFF, 0xFF, 0xFF, 0xFF,     //     LOGICAL_MAXIMUM (4294967295)
+       0x75, 0x20,                       //     REPORT_SIZE (32)
+       0x81, 0x02,                       //     INPUT (Data,Var,Abs)
+       0x05, 0x20,                       //     USAGE_PAGE (Sensors)
+       0xC0,                             //   END_COLLECTION
+       0x85, 0x02,                       //   REPORT_ID (2)
+       0x09, 0x32,                       //   USAGE (Environmental: Humidity)
+       0xA1, 0x00,                       //   COLLECTION (Physical)
+       0x0A, 0x01, 0x02,                 //     USAGE (Sensor State)
+       0x15, 0x00,                       //     LOGICAL_MINIMUM (0)
+       0x25, 0x06,                       //     LOGICAL_MAXIMUM (6)
+       0x75, 0x08,                       //     REPORT_SIZE (8)
+       0x95, 0x01,                       //     REPORT_COUNT (1)
+       0xA1, 0x02,                       //     COLLECTION (Logical)
+       0x1A, 0x00, 0x08,                 //       USAGE_MINIMUM (Sensor State: Undefined)
+       0x2A, 0x06, 0x08,                 //       USAGE_MAXIMUM (Sensor State: Error)
+       0x81, 0x00,                       //       INPUT (Data,Ary,Abs)
+       0xC0,                             //     END_COLLECTION
+       0x0A, 0x02, 0x02,                 //     USAGE (Sensor Event)
+       0x25, 0x05,                       //     LOGICAL_MAXIMUM (5)
+       0xA1, 0x02,                       //     COLLECTION (Logical)
+       0x1A, 0x10, 0x08,                 //       USAGE_MINIMUM (Sensor Event: Unknown)
+       0x2A, 0x15, 0x08,                 //       USAGE_MAXIMUM (Sensor Event: Change Sensitivity)
+       0x81, 0x00,                       //       INPUT (Data,Ary,Abs)
+       0xC0,                             //     END_COLLECTION
+       0x0A, 0x33, 0x04,                 //     USAGE (Environmental Relative Humidity)
+       0x15, 0x00,                       //     LOGICAL_MINIMUM (0)
+       0x26, 0x10, 0x27,                 //     LOGICAL_MAXIMUM (10000)
+       0x75, 0x10,                       //     REPORT_SIZE (16)
+       0x55, 0x0E,                       //     UNIT_EXPONENT (-2)
+       0x81, 0x02,                       //     INPUT (Data,Var,Abs)
+       0x06, 0x00, 0xFF,                 //     USAGE_PAGE (Vendor Defined)
+       0x09, 0x01,                       //     USAGE (Timestamp RTC, 1/4096 s)
+       0x15, 0x00,                       //     LOGICAL_MINIMUM (0)
+       0x27, 0xFF, 0xFF, 0xFF, 0xFF,     //     LOGICAL_MAXIMUM (4294967295)
+       0x75, 0x20,                       //     REPORT_SIZE (32)
+       0x81, 0x02,                       //     INPUT (Data,Var,Abs)
+       0x05, 0x20,                       //     USAGE_PAGE (Sensors)
+       0xC0,                             //   END_COLLECTION
+       0x85, 0x03,                       //   REPORT_ID (3)
+       0x09, 0x31,                       //   USAGE (Environmental: Atmospheric Pressure)
+       0xA1, 0x00,                       //   COLLECTION (Physical)
+       0x0A, 0x01, 0x02,                 //     USAGE (Sensor State)
+       0x15, 0x00,                       //     LOGICAL_MINIMUM (0)
+       0x25, 0x06,                       //     LOGICAL_MAXIMUM (6)
+       0x75, 0x08,                       //     REPORT_SIZE (8)
+       0x95, 0x01,                       //     REPORT_COUNT (1)
+       0xA1, 0x02,                       //     COLLECTION (Logical)
+       0x1A, 0x00, 0x08,                 //       USAGE_MINIMUM (Sensor State: Undefined)
+       0x2A, 0x06, 0x08,                 //       USAGE_MAXIMUM (Sensor State: Error)
+       0x81, 0x00,                       //       INPUT (Data,Ary,Abs)
+       0xC0,                             //     END_COLLECTION
+       0x0A, 0x02, 0x02,                 //     USAGE (Sensor Event)
+       0x25, 0x05,                       //     LOGICAL_MAXIMUM (5)
+       0xA1, 0x02,                       //     COLLECTION (Logical)
+       0x1A, 0x10, 0x08,                 //       USAGE_MINIMUM (Sensor Event: Unknown)
+       0x2A, 0x15, 0x08,                 //       USAGE_MAXIMUM (Sensor Event: Change Sensitivity)
+       0x81, 0x00,                       //       INPUT (Data,Ary,Abs)
+       0xC0,                             //     END_COLLECTION
+       0x0A, 0x31, 0x04,                 //     USAGE (Environmental Atmospheric Pressure)
+       0x15, 0x00,                       //     LOGICAL_MINIMUM (0)
+       0x27, 0xFF, 0xFF, 0xFF, 0x7F,     //     LOGICAL_MAXIMUM (2147483647)
+       0x75, 0x20,                       //     REPORT_SIZE (32)
+       0x55, 0x0B,                       //     UNIT_EXPONENT (-5)
+       0x81, 0x02,                       //     INPUT (Data,Var,Abs)
+       0x06, 0x00, 0xFF,                 //     USAGE_PAGE (Vendor Defined)
+       0x09, 0x01,                       //     USAGE (Timestamp RTC, 1/4096 s)
+       0x15, 0x00,                       //     LOGICAL_MINIMUM (0)
+       0x27, 0xFF, 0xFF, 0xFF, 0xFF,     //     LOGICAL_MAXIMUM (4294967295)
+       0x75, 0x20,                       //     REPORT_SIZE (32)
+       0x81, 0x02,                       //     INPUT (Data,Var,Abs)
+       0x05, 0x20,                       //     USAGE_PAGE (Sensors)
+       0xC0,                             //   END_COLLECTION
+       0xC0                              // END_COLLECTION
+     }
+  };
+
+// Descritor de idioma
+const struct {
+  char bLength;
+  char bDscType;
+  unsigned int string[1];
+  } strd1 = {
+      4,
+      0x03,
+      {0x0409}                                                                  // Inglês (EUA)
+    };
+
+// Descritor do fabricante
+const struct{
+  char bLength;
+  char bDscType;
+  unsigned int string[8];
+  }strd2={
+    18,                                                                         // Tamanho deste descritor
+    0x03,
+    {'g','e','n','l','i','c','o','s'}
+  };
+
+// Descritor do produto
+const struct{
+  char bLength;
+  char bDscType;
+  unsigned int string[17];
+  }strd3={
+    36,                                                                         // Tamanho deste descritor
+    0x03,
+    {'B','M','E','2','8','0',' ','H','I','D',' ','S','e','n','s','o','r'}
+  };
+
+// Vetor de descritores de configuração
+const char* USB_config_dsc_ptr[1];
+
+// Vetor de descritores de string
+const char* USB_string_dsc_ptr[3];
+
+void USB_Init_Desc(){
+  USB_config_dsc_ptr[0] = &configDescriptor1;
+  USB_string_dsc_ptr[0] = (const char*)&strd1;
+  USB_string_dsc_ptr[1] = (const char*)&strd2;
+  USB_string_dsc_ptr[2] = (const char*)&strd3;
+}
+
+#endif
@@ -0,0 +1,229 @@
+/******************************************************************************
+ * Biblioteca: Amostragem adaptativa (adaptativo.c)
+ * Autor: Elison Nogueira
+ * Data: 18/10/2026
+ * Versão: 1.0
+ * Plataforma: PIC18F25K50 (Microchip)
+ * Compilador: mikroC Pro for PIC v7.6.0
+ *
+ * Descrição:
+ * Controlador de taxa de amostragem pela derivada de T/UR/P.
+ * Veja adaptativo.h.
+ ******************************************************************************/
+
+#include "adaptativo.h"
+#include "bme280.h"
+#include "rtc.h"
+#include "sched.h"
+
+// Tabela de níveis: modo do sensor, standby e período de leitura
+const bme280_mode adpt_modo[ADPT_NIVEIS] = {MODE_NORMAL, MODE_NORMAL, MODE_SLEEP, MODE_SLEEP};
+const standby_time adpt_standby[ADPT_NIVEIS] = {STANDBY_62_5, STANDBY_500, STANDBY_1000, STANDBY_1000};
+const unsigned long adpt_periodo[ADPT_NIVEIS] = {RTC_MS(250), RTC_MS(1000), RTC_MS(2000), RTC_MS(10000)};
+
+unsigned char adpt_nivel;                                                       // Nível atual
+unsigned char adpt_fixo;                                                        // Nível fixado por ADPT_Lock
+unsigned char adpt_calmas;                                                      // Amostras calmas consecutivas
+unsigned char adpt_primeira;                                                    // 1 = ainda não há amostra anterior
+unsigned long adpt_ts;                                                          // Timestamp da amostra anterior
+long adpt_t;                                                                    // Amostra anterior
+unsigned long adpt_h, adpt_p;
+
+unsigned long adpt_leitura;                                                     // Período de leitura do nível (k ciclos no modo normal)
+unsigned long adpt_ciclo;                                                       // Ciclo do sensor no modo normal (ticks)
+unsigned long adpt_nominal;                                                     // Ciclo calculado pelo datasheet (ticks)
+unsigned char adpt_k;                                                           // Ciclos por leitura
+unsigned long adpt_meia;                                                        // Meia conversão (ticks): antecipação do prazo
+unsigned long adpt_fim;                                                         // Fim da última conversão observada
+unsigned long adpt_busca;                                                       // Início da busca pela borda
+unsigned char adpt_travado;                                                     // 1 = fase conhecida
+unsigned char adpt_buscando;                                                    // 1 = consultando o status
+unsigned char adpt_medindo;                                                     // 1 = a busca já viu conversão em andamento
+
+// Converte µs em ticks do RTC (4096/10^6 = 512/125000), arredondando
+static unsigned long ADPT_Ticks(unsigned long us) {
+    return (us * 512 + 62500) / 125000;
+}
+
+// Recalcula o ciclo do sensor e o período alinhado do nível; descarta a fase
+void ADPT_Resync(void) {
+    unsigned long k;
+
+    adpt_travado = 0;
+    adpt_buscando = 0;
+    adpt_leitura = adpt_periodo[adpt_nivel];
+    if(adpt_modo[adpt_nivel] != MODE_NORMAL)
+        return;
+
+    adpt_nominal = ADPT_Ticks(BME280_NormalPeriod());
+    adpt_ciclo = adpt_nominal;
+    adpt_meia = ADPT_Ticks(BME280_MeasTime(BME280_cfg.T_sampling, BME280_cfg.H_sampling,
+                                           BME280_cfg.P_sampling)) >> 1;
+
+    k = (adpt_leitura + (adpt_ciclo >> 1)) / adpt_ciclo;                        // Ciclos inteiros mais próximos
+    if(k == 0)
+        k = 1;
+    adpt_k = (unsigned char)k;
+    adpt_leitura = k * adpt_ciclo;
+}
+
+// Ajusta o ciclo pelo intervalo entre duas bordas (oscilador do sensor x RTC)
+static void ADPT_Learn(unsigned long decorrido) {
+    unsigned long n, medido;
+
+    n = (decorrido + (adpt_ciclo >> 1)) / adpt_ciclo;                           // Ciclos entre as duas bordas
+    if(n == 0)
+        return;
+
+    medido = decorrido / n;
+    if(medido > adpt_nominal + (adpt_nominal >> 3) ||                           // Fora de ±12.5%: borda perdida ou falha
+       medido < adpt_nominal - (adpt_nominal >> 3))
+        return;
+
+    if(n != adpt_k)
+        adpt_ciclo = medido;                                                    // Borda perdida por deriva: corrige de uma vez
+    else
+        adpt_ciclo += ((long)medido - (long)adpt_ciclo) / 4;                    // Média exponencial (ganho 1/4)
+    adpt_leitura = adpt_k * adpt_ciclo;
+}
+
+// Grava no sensor o modo e o standby do nível, mantendo oversampling e filtro
+static void ADPT_Apply(void) {
+    BME280_Configure(adpt_modo[adpt_nivel], BME280_cfg.T_sampling,
+                     BME280_cfg.H_sampling, BME280_cfg.P_sampling,
+                     BME280_cfg.filter, adpt_standby[adpt_nivel]);
+    ADPT_Resync();
+}
+
+// Verifica se |atual - anterior| excede o limiar por segundo no intervalo dt
+static unsigned char ADPT_Fast(long atual, long anterior, long limiar, unsigned long dt) {
+    long d;
+
+    d = atual - anterior;
+    if(d < 0) d = -d;
+    if(d > 0xFFFFF)                                                             // d * RTC_HZ passaria de 32 bits
+        return 1;
+
+    return ((unsigned long)d * RTC_HZ) > ((unsigned long)limiar * dt);
+}
+
+// Aplica o nível padrão (ou o fixado) ao sensor
+void ADPT_Init(void) {
+    adpt_nivel = adpt_fixo < ADPT_NIVEIS ? adpt_fixo : ADPT_NIVEL_PADRAO;
+    adpt_calmas = 0;
+    adpt_primeira = 1;
+    ADPT_Apply();
+}
+
+// Avalia a derivada das grandezas e troca de nível quando necessário
+void ADPT_Update(unsigned long ts, long temp, unsigned long humi, unsigned long pres) {
+    unsigned long dt;
+    unsigned char rapido;
+
+    dt = ts - adpt_ts;
+    if(adpt_primeira || dt > (unsigned long)ADPT_DT_MAX * RTC_HZ) {             // Sem amostra anterior recente para derivar
+        adpt_primeira = 0;
+        rapido = 0;
+    } else {
+        if(dt > (unsigned long)ADPT_DT_DEGRAU * RTC_HZ)                         // Degrau não se dilui no período longo
+            dt = (unsigned long)ADPT_DT_DEGRAU * RTC_HZ;
+        rapido = ADPT_Fast(temp, adpt_t, ADPT_LIMIAR_T, dt) ||
+                 ADPT_Fast((long)humi, (long)adpt_h, ADPT_LIMIAR_H, dt) ||
+                 ADPT_Fast((long)pres, (long)adpt_p, ADPT_LIMIAR_P, dt);
+    }
+
+    adpt_ts = ts;
+    adpt_t = temp;
+    adpt_h = humi;
+    adpt_p = pres;
+
+    if(adpt_fixo < ADPT_NIVEIS)                                                 // Nível fixo: só acompanha as amostras
+        return;
+
+    if(rapido) {                                                                // Transiente: vai direto ao nível mais rápido
+        adpt_calmas = 0;
+        if(adpt_nivel != 0) {
+            adpt_nivel = 0;
+            ADPT_Apply();
+        }
+        return;
+    }
+
+    if(++adpt_calmas < ADPT_DECAIMENTO)
+        return;
+
+    adpt_calmas = 0;                                                            // Estável: desce um nível
+    if(adpt_nivel < ADPT_NIVEIS - 1) {
+        adpt_nivel++;
+        ADPT_Apply();
+    }
+}
+
+// Fixa um nível (ADPT_AUTOMATICO libera) e o aplica ao sensor
+void ADPT_Lock(unsigned char nivel) {
+    adpt_fixo = nivel;
+    ADPT_Init();
+}
+
+// Retorna o período de leitura do nível atual em ticks do RTC
+unsigned long ADPT_Interval(void) {
+    return adpt_leitura;
+}
+
+// Com o prazo vencido, decide se já pode ler; no modo normal espera a borda do measuring
+unsigned char ADPT_Sync(unsigned long *prazo) {
+    unsigned long agora;
+
+    if(adpt_modo[adpt_nivel] != MODE_NORMAL)                                    // Forçado: a leitura dispara a conversão
+        return 1;
+
+    agora = RTC_Now();
+    if(!adpt_buscando) {
+        adpt_buscando = 1;
+        adpt_medindo = 0;
+        adpt_busca = agora;
+    }
+
+    if(BME280_Measuring()) {                                                    // Conversão em andamento: consulta de novo
+        adpt_medindo = 1;
+        *prazo = agora + ADPT_SONDA;
+        return 0;
+    }
+
+    if(adpt_medindo) {                                                          // Borda de descida: dados novos e estáveis
+        if(adpt_travado)
+            ADPT_Learn(agora - adpt_fim);
+        adpt_buscando = 0;
+        adpt_travado = 1;
+        adpt_fim = agora;
+        return 1;
+    }
+
+    if(agora - adpt_busca > adpt_ciclo + ADPT_SONDA) {                          // Nenhuma conversão vista em um ciclo
+        adpt_buscando = 0;
+        adpt_travado = 0;
+        BME280_MarkConversion();                                                // Um ciclo inteiro passou: há dado novo
+        return 1;
+    }
+
+    *prazo = agora + ADPT_SONDA;                                                // Standby: a conversão ainda não começou
+    return 0;
+}
+
+// Agenda a próxima leitura: em fase com o sensor quando travado, senão pelo período
+void ADPT_Schedule(unsigned long *prazo) {
+    if(adpt_travado)
+        *prazo = adpt_fim + adpt_leitura - adpt_meia;                           // Chega no meio da conversão esperada
+    else
+        SCH_Next(prazo, adpt_leitura);
+}
+
+// Retorna 1 se o nível atual usa medição forçada
+unsigned char ADPT_Forced(void) {
+    return adpt_modo[adpt_nivel] == MODE_SLEEP;
+}
+
+// Retorna o nível atual
+unsigned char ADPT_Level(void) {
+    return adpt_nivel;
+}
@@ -0,0 +1,95 @@
+/******************************************************************************
+ * Biblioteca: Amostragem adaptativa (adaptativo.h)
+ * Autor: Elison Nogueira
+ * Data: 18/10/2026
+ * Versão: 1.0
+ * Plataforma: PIC18F25K50 (Microchip)
+ * Compilador: mikroC Pro for PIC v7.6.0
+ *
+ * Descrição:
+ * Controlador que ajusta a taxa de amostragem pela taxa de variação das
+ * grandezas. Quando a derivada de T, UR ou P ultrapassa o limiar, o sensor
+ * vai direto para o nível mais rápido; após ADPT_DECAIMENTO amostras calmas
+ * consecutivas ele desce um nível em direção ao modo de baixo consumo.
+ *
+ *   Nível  Modo do BME280              Período de leitura
+ *   0      Normal, standby 62.5ms      282ms   (transientes, alinhado)
+ *   1      Normal, standby 500ms       1016ms  (alinhado)
+ *   2      Forçado                     2s      (padrão)
+ *   3      Forçado                     10s     (baixo consumo)
+ *
+ * A comparação da derivada é feita sem divisão:
+ *   |dX| * RTC_HZ > limiar_por_segundo * min(dt, ADPT_DT_DEGRAU)
+ * com dt em ticks do RTC. O intervalo entra limitado a ADPT_DT_DEGRAU
+ * porque um degrau (porta abrindo, HVAC ligando) dividido pelos 10s do
+ * nível 3 ficaria abaixo do limiar: com o limite, uma diferença maior que
+ * 2s de limiar sobe o nível em qualquer período. O preço é que no nível 3
+ * uma rampa acima de 1/5 do limiar também sobe; nos níveis rápidos ela é
+ * calma e o nível volta a descer. Os dois lados cabem em 32 bits e |dX| de
+ * 2^20 ou mais já é rápido sem multiplicar. Um intervalo maior que
+ * ADPT_DT_MAX (depois de uma sessão longa do variômetro, por exemplo) não dá
+ * derivada: a amostra só recomeça a referência, como a primeira.
+ *
+ * Os limiares e o decaimento foram conferidos em adaptativo_teste.c com o
+ * ruído no alvo do autoajuste e no dobro: degraus de 0.5°C, 5%UR e 50Pa e
+ * rampas de 2x o limiar levam ao nível 0 na primeira leitura em que passam
+ * do limiar, rampa de 1/10 do limiar não sobe, o sinal parado não sobe e a
+ * volta ao nível 3 leva 8 leituras de cada nível (~26s).
+ *
+ * Alinhamento nos níveis de modo normal: o sensor converte sozinho a cada
+ *   ciclo = t_conversão (típico, pelo oversampling) + t_standby
+ * e ler em fase arbitrária lê a mesma conversão duas vezes ou pula outras
+ * de forma irregular. Por isso o período de leitura desses níveis é
+ * arredondado para k ciclos inteiros, e a leitura só é feita logo após o
+ * bit measuring do status cair (ADPT_Sync): o prazo é marcado para o meio
+ * da conversão esperada e o status é consultado a cada ADPT_SONDA até a
+ * borda. Cada leitura mede a fase de novo, e o intervalo entre bordas
+ * corrige o ciclo (média com ganho 1/4, ou direto após uma borda perdida;
+ * limite de ±12.5% do calculado), então a deriva entre o oscilador do
+ * sensor e o RTC não se acumula. Chegar cedo só custa mais consultas;
+ * chegar mais de meia conversão atrasado faz a leitura usar a borda
+ * seguinte (um ciclo de atraso). Sem ver conversão por um ciclo inteiro a
+ * leitura é feita assim mesmo e a fase é descartada.
+ *
+ * adaptativo_teste.c (teste_host.py) roda este arquivo contra um sensor simulado
+ * com erro de relógio de -2% a +2% e conversão típica ou máxima: nenhuma
+ * conversão lida duas vezes e a leitura sai até 2.2ms após a borda (maior
+ * visto: 2.12ms, com consulta de 250us e até 200us de atraso no laço).
+ *
+ *   Nível  Ciclo (x1, standby)  k  Leitura
+ *   0      8ms + 62.5ms         4  282ms
+ *   1      8ms + 500ms          2  1016ms
+ *
+ * ADPT_Lock fixa um nível (perfil escolhido pela serial, veja cmd.h): as
+ * amostras continuam alimentando a derivada, mas o nível não muda.
+ * ADPT_AUTOMATICO devolve o controle ao algoritmo acima.
+ *****************************************************************************/
+
+#ifndef ADAPTATIVO_H
+#define ADAPTATIVO_H
+
+#define ADPT_NIVEIS       4                                                     // Número de níveis de amostragem
+#define ADPT_NIVEL_PADRAO 2                                                     // Nível inicial
+#define ADPT_AUTOMATICO   0xFF                                                  // ADPT_Lock: sem nível fixo
+#define ADPT_SONDA        8                                                     // Consulta ao status durante o alinhamento (~2ms)
+#define ADPT_DECAIMENTO   8                                                     // Amostras calmas para descer um nível
+#define ADPT_DT_MAX       600                                                   // Maior intervalo com derivada (s)
+#define ADPT_DT_DEGRAU    2                                                     // Maior intervalo no denominador da derivada (s)
+
+// Limiares de derivada por segundo
+#define ADPT_LIMIAR_T     5                                                     // 0.05°C/s
+#define ADPT_LIMIAR_H     512                                                   // 0.5%/s
+#define ADPT_LIMIAR_P     20                                                    // 20Pa/s (porta, HVAC)
+
+// Protótipos das funções
+void ADPT_Init(void);                                                           // Aplica o nível padrão ao sensor
+void ADPT_Update(unsigned long ts, long temp, unsigned long humi, unsigned long pres); // Avalia a derivada e troca de nível
+void ADPT_Lock(unsigned char nivel);                                            // Fixa um nível (ou ADPT_AUTOMATICO)
+unsigned long ADPT_Interval(void);                                              // Período de leitura atual (ticks do RTC)
+unsigned char ADPT_Sync(unsigned long *prazo);                                  // 1 = pode ler agora; 0 = prazo adiado para nova consulta
+void ADPT_Schedule(unsigned long *prazo);                                       // Próximo prazo de leitura (em fase no modo normal)
+void ADPT_Resync(void);                                                         // Recalcula o ciclo após mudar oversampling ou standby
+unsigned char ADPT_Forced(void);                                                // 1 = nível atual usa modo forçado
+unsigned char ADPT_Level(void);                                                 // Nível atual
+
+#endif
@@ -0,0 +1,394 @@
+/******************************************************************************
+ * Teste no host: Alinhamento da leitura ao ciclo do sensor (adaptativo_teste.c)
+ * Autor: Elison Nogueira
+ * Data: 18/10/2026
+ * Versão: 1.0
+ * Plataforma: PC (gcc)
+ *
+ * Descrição:
+ * Compila o adaptativo.c do firmware contra um BME280 simulado em modo
+ * normal e roda o laço de leitura do main.c (SCH_Due, ADPT_Sync, leitura,
+ * ADPT_Schedule) por TST_DURACAO em cada caso:
+ *
+ *   Nível         0 e 1 (os de modo normal), x1/x1/x1
+ *   Relógio       erro do oscilador do sensor de -2% a +2% (passo 0.5%),
+ *                 aplicado à conversão e ao standby
+ *   Conversão     típica (8ms) e máxima do datasheet (9.3ms) a x1
+ *   Fase          TST_FASES fases iniciais do sensor
+ *
+ * O RTC é exato (cristal de 32768Hz). Cada consulta ao status leva TST_I2C
+ * us e o bit é amostrado no fim dela; a leitura dos brutos começa quando
+ * ADPT_Sync retorna 1. Cada volta do laço ainda atrasa até TST_ATRASO us
+ * (outras tarefas), com sorteio reprodutível.
+ *
+ * Verifica por leitura:
+ *   - nenhuma conversão lida duas vezes (duplicada)
+ *   - atraso entre o fim da conversão e a leitura até TST_LIMITE us,
+ *     exceto nas leituras sem fase (ADPT_Sync desistiu de esperar a borda)
+ * e informa as conversões puladas além das k-1 de cada período e as
+ * consultas ao status por leitura depois dos primeiros 10s.
+ *
+ * Também roda ADPT_Update (nível automático) com as leituras no período
+ * de cada nível, sinal constante mais ruído gaussiano e uma mudança por
+ * cenário a partir de TST_INICIO mais TST_FASES fases de um período do
+ * nível 3:
+ *
+ *   Mudança       T            UR           P            Espera-se
+ *   Degrau        +0.5°C       +5%          +50Pa        ir ao nível 0
+ *   Rampa rápida  2x o limiar por TST_RAMPA segundos     ir ao nível 0 e
+ *                                                        ficar nele
+ *   Rampa lenta   1/10 do limiar por TST_RAMPA segundos  não subir
+ *
+ * com o ruído no alvo do autoajuste (autoajuste.h: 0.005°C, 0.024%UR,
+ * 0.7Pa) e no dobro dele. Verifica por cenário:
+ *   - a mudança rápida leva ao nível 0 em até TST_SUBIDA segundos (uma
+ *     leitura do nível 3 depois de a rampa passar de 2s de limiar)
+ *   - o nível fica em 0 até o fim da rampa rápida
+ *   - o nível volta ao 3 em até TST_VOLTA segundos depois do fim da
+ *     mudança (do degrau: depois da subida)
+ *   - nenhuma subida ao nível 0 com o sinal parado
+ * As duas últimas só com o ruído no alvo; no dobro elas são informadas.
+ *
+ * Não compila sozinho: teste_host.py copia o adaptativo.c com os tipos do
+ * mikroC e compila este arquivo contra ele (veja lá).
+ *
+ * Uso: python3 teste_host.py adaptativo
+ * Sai com 1 se alguma verificação falhar.
+ *****************************************************************************/
+
+#include <stdio.h>
+#include <stdint.h>
+#include <math.h>
+
+#include "adaptativo_host.c"
+
+#define TST_DURACAO       60.0e6                                                // Duração de cada caso (us)
+#define TST_FASES         4                                                     // Fases iniciais do sensor por caso
+#define TST_I2C           250.0                                                 // Consulta ao status (us, 100kHz)
+#define TST_RAJADA        900.0                                                 // Leitura dos brutos (us)
+#define TST_ATRASO        200.0                                                 // Maior atraso de uma volta do laço (us)
+#define TST_LIMITE        2200.0                                                // Maior atraso aceito após a borda (us)
+#define TST_INICIO        120.0                                                 // Início da mudança (s), mais a fase
+#define TST_RAMPA         60.0                                                  // Duração das rampas (s)
+#define TST_FIM           400.0                                                 // Duração de cada cenário (s)
+#define TST_VOLTA         30.0                                                  // Maior volta ao nível 3 aceita (s)
+#define TST_SUBIDA        11.0                                                  // Maior subida ao nível 0 aceita (s)
+
+config_bme280 BME280_cfg;
+
+// Sensor simulado: conversões em fase + n * ciclo, cada uma com duração conv
+double tst_agora;                                                               // Tempo simulado (us)
+double tst_fase, tst_ciclo, tst_conv;
+unsigned int tst_consultas;
+unsigned int tst_desistiu;
+uint32_t tst_semente = 1;
+
+// Sorteio reprodutível (xorshift de 32 bits) em [0, 1)
+static double TST_Random(void) {
+    tst_semente ^= tst_semente << 13;
+    tst_semente ^= tst_semente >> 17;
+    tst_semente ^= tst_semente << 5;
+    return (tst_semente >> 8) / 16777216.0;
+}
+
+// Sorteio gaussiano de desvio padrão 1 (Box-Muller)
+static double TST_Gauss(void) {
+    double u = TST_Random();
+
+    return sqrt(-2 * log(1 - u)) * cos(2 * M_PI * TST_Random());
+}
+
+// Conversões terminadas até o instante t (-1 = nenhuma)
+static int32_t TST_Fim(double t) {
+    if(t < tst_fase + tst_conv)
+        return -1;
+    return (int32_t)((t - tst_fase - tst_conv) / tst_ciclo);
+}
+
+// Substitutos do driver, do RTC e do escalonador (mesmas fórmulas do firmware)
+uint32_t RTC_Now(void) {
+    return (uint32_t)(tst_agora * RTC_HZ / 1e6);
+}
+
+void SCH_Next(uint32_t *prazo, uint32_t periodo) {
+    uint32_t agora = RTC_Now();
+
+    *prazo += periodo;
+    if((int32_t)(agora - *prazo) >= 0)
+        *prazo = agora + periodo;
+}
+
+void BME280_Configure(bme280_mode mode, bme280_sampling osrs_t, bme280_sampling osrs_h,
+                      bme280_sampling osrs_p, bme280_filter filter, standby_time sb) {
+    BME280_cfg.mode = mode;
+    BME280_cfg.T_sampling = osrs_t;
+    BME280_cfg.H_sampling = osrs_h;
+    BME280_cfg.P_sampling = osrs_p;
+    BME280_cfg.filter = filter;
+    BME280_cfg.standby = sb;
+}
+
+uint32_t BME280_MeasTime(unsigned char osrs_t, unsigned char osrs_h, unsigned char osrs_p) {
+    return 1250 + 2300 * 3 + 575 * 2;                                           // x1/x1/x1 (único caso testado)
+}
+
+uint32_t BME280_NormalPeriod(void) {
+    return 1000 + 2000 * 3 + 500 * 2 + (BME280_cfg.standby == STANDBY_62_5 ? 62500 : 500000);
+}
+
+unsigned char BME280_Measuring(void) {
+    double t;
+
+    tst_consultas++;
+    tst_agora += TST_I2C;
+    t = tst_agora - tst_fase;
+    return t >= 0 && t - (int32_t)(t / tst_ciclo) * tst_ciclo < tst_conv;
+}
+
+void BME280_MarkConversion(void) {
+    tst_desistiu++;
+}
+
+// Resultado de um caso
+typedef struct {
+    unsigned int leituras, duplicadas, puladas, fora, sem_fase;
+    double atraso_max;
+    double consultas;                                                           // Por leitura, após 10s
+} tst_resultado;
+
+// Roda o laço de leitura por TST_DURACAO
+static void TST_Case(unsigned char nivel, double erro, double conv, double fase, tst_resultado *r) {
+    uint32_t prazo;
+    int32_t ultima, n;
+    unsigned int leituras_10s, consultas_10s, desistiu;
+    double atraso, padrao;
+
+    BME280_Configure(MODE_NORMAL, SAMPLING_X1, SAMPLING_X1, SAMPLING_X1, FILTER_OFF, STANDBY_62_5);
+    padrao = nivel == 0 ? 62500.0 : 500000.0;
+    tst_conv = conv * (1 + erro);
+    tst_ciclo = (conv + padrao) * (1 + erro);
+    tst_fase = fase * tst_ciclo;
+    tst_agora = 0;
+    tst_consultas = 0;
+    tst_desistiu = 0;
+
+    ADPT_Lock(nivel);
+
+    r->leituras = r->duplicadas = r->puladas = r->fora = r->sem_fase = 0;
+    r->atraso_max = 0;
+    leituras_10s = consultas_10s = 0;
+    ultima = -2;
+    prazo = RTC_Now();
+
+    while(tst_agora < TST_DURACAO) {
+        // SCH_Due: acorda no tick do prazo, mais o resto da volta do laço
+        if((int32_t)(RTC_Now() - prazo) < 0)
+            tst_agora = (double)prazo * 1e6 / RTC_HZ;
+        tst_agora += TST_ATRASO * TST_Random();
+
+        desistiu = tst_desistiu;
+        if(!ADPT_Sync(&prazo))
+            continue;
+
+        // Leitura dos brutos: vale a última conversão terminada
+        n = TST_Fim(tst_agora);
+        if(n >= 0) {
+            r->leituras++;
+            if(n == ultima)
+                r->duplicadas++;
+            else if(ultima >= 0 && n - ultima > adpt_k)
+                r->puladas += n - ultima - adpt_k;
+
+            atraso = tst_agora - (tst_fase + n * tst_ciclo + tst_conv);
+            if(tst_desistiu != desistiu)
+                r->sem_fase++;
+            else {
+                if(atraso > r->atraso_max)
+                    r->atraso_max = atraso;
+                if(atraso > TST_LIMITE)
+                    r->fora++;
+            }
+
+            if(tst_agora > 10.0e6) {
+                leituras_10s++;
+                consultas_10s += tst_consultas;
+            }
+            ultima = n;
+        }
+        tst_consultas = 0;
+        tst_agora += TST_RAJADA;
+
+        ADPT_Schedule(&prazo);
+    }
+
+    r->consultas = leituras_10s ? (double)consultas_10s / leituras_10s : 0;
+}
+
+// Cenário da derivada: mudança num canal (0 = T, 1 = UR, 2 = P)
+typedef struct {
+    const char *nome;
+    unsigned char canal;
+    double degrau;                                                              // Salto no início (unidade do canal)
+    double taxa;                                                                // Rampa por segundo durante TST_RAMPA
+    unsigned char rapida;                                                       // 1 = deve levar ao nível 0
+} tst_cenario;
+
+// Unidades de ADPT_Update: 0.01°C, 1/1024 %UR, Pa
+static const double tst_base[3] = {2500, 50 * 1024.0, 101325};
+static const double tst_ruido[3] = {0.5, 0.024 * 1024, 0.7};                    // Alvos do autoajuste
+
+static const tst_cenario tst_cenarios[] = {
+    {"Degrau T",        0, 50,        0,                        1},
+    {"Degrau UR",       1, 5 * 1024,  0,                        1},
+    {"Degrau P",        2, 50,        0,                        1},
+    {"Rampa rapida T",  0, 0,         2 * ADPT_LIMIAR_T,        1},
+    {"Rampa rapida UR", 1, 0,         2 * ADPT_LIMIAR_H,        1},
+    {"Rampa rapida P",  2, 0,         2 * ADPT_LIMIAR_P,        1},
+    {"Rampa lenta T",   0, 0,         0.1 * ADPT_LIMIAR_T,      0},
+    {"Rampa lenta UR",  1, 0,         0.1 * ADPT_LIMIAR_H,      0},
+    {"Rampa lenta P",   2, 0,         0.1 * ADPT_LIMIAR_P,      0},
+};
+#define TST_CENARIOS      (sizeof(tst_cenarios) / sizeof(tst_cenarios[0]))
+
+// Resultado de um cenário (tempos em s; -1 = não aconteceu)
+typedef struct {
+    double subida;                                                              // Do início da mudança ao nível 0
+    double volta;                                                               // Do fim da mudança (ou da subida) ao nível 3
+    unsigned int desceu;                                                        // Leituras fora do nível 0 na rampa rápida
+    unsigned int falsas;                                                        // Subidas ao nível 0 com o sinal parado
+} tst_derivada;
+
+double tst_inicio;                                                              // Início da mudança no cenário atual (s)
+
+// Valor lido do canal no instante t (s): sinal, mudança e ruído quantizado
+static double TST_Signal(const tst_cenario *c, unsigned char canal, double t, double ruido) {
+    double v = tst_base[canal];
+
+    if(canal == c->canal && t >= tst_inicio) {
+        v += c->degrau;
+        v += c->taxa * (t < tst_inicio + TST_RAMPA ? t - tst_inicio : TST_RAMPA);
+    }
+
+    return floor(v + ruido * tst_ruido[canal] * TST_Gauss() + 0.5);
+}
+
+// Roda um cenário com o nível automático e as leituras no período do nível
+static void TST_Derivative(const tst_cenario *c, double ruido, tst_derivada *r) {
+    double t, fim, volta;
+    unsigned char nivel, anterior;
+
+    fim = tst_inicio + (c->taxa ? TST_RAMPA : 0);
+    volta = fim;
+    BME280_Configure(MODE_SLEEP, SAMPLING_X1, SAMPLING_X1, SAMPLING_X1, FILTER_OFF, STANDBY_1000);
+    ADPT_Lock(ADPT_AUTOMATICO);
+    tst_semente = 1;
+    r->subida = r->volta = -1;
+    r->desceu = r->falsas = 0;
+    anterior = ADPT_Level();
+
+    for(t = 0; t < TST_FIM; t += ADPT_Interval() / (double)RTC_HZ) {
+        tst_agora = t * 1e6;
+        ADPT_Update(RTC_Now(), (int32_t)TST_Signal(c, 0, t, ruido),
+                    (uint32_t)TST_Signal(c, 1, t, ruido), (uint32_t)TST_Signal(c, 2, t, ruido));
+        nivel = ADPT_Level();
+
+        if(t >= tst_inicio && nivel == 0 && r->subida < 0) {
+            r->subida = t - tst_inicio;
+            if(t > volta)                                                       // Degrau: a descida conta da subida
+                volta = t;
+        }
+        if(c->rapida && r->subida >= 0 && t <= fim && nivel != 0)
+            r->desceu++;
+        if(t > volta && nivel == 3 && r->volta < 0)
+            r->volta = t - volta;
+        if(nivel == 0 && anterior != 0 && (t < tst_inicio || t > fim + 10.0))   // Sinal parado (a leitura após a mudança ainda a vê)
+            r->falsas++;
+        anterior = nivel;
+    }
+}
+
+// Roda os cenários da derivada nos dois ruídos, pior caso das fases; retorna as falhas
+static unsigned int TST_Derivatives(void) {
+    tst_derivada r, f;
+    unsigned int i, falhas = 0;
+    unsigned char ruido, falhou, fase, perdeu, ficou;
+
+    printf("\nCenário          Ruído  Subida  Volta ao 3  Fora do 0  Subidas falsas\n");
+    for(ruido = 1; ruido <= 2; ruido++) {
+        for(i = 0; i < TST_CENARIOS; i++) {
+            r.subida = r.volta = -1;
+            r.desceu = r.falsas = 0;
+            perdeu = ficou = 0;
+            for(fase = 0; fase < TST_FASES; fase++) {
+                tst_inicio = TST_INICIO + fase * 10.0 / TST_FASES;
+                TST_Derivative(&tst_cenarios[i], ruido, &f);
+                if(f.subida < 0)
+                    perdeu = 1;
+                if(f.subida > r.subida)
+                    r.subida = f.subida;
+                if(f.volta < 0)
+                    ficou = 1;
+                else if(f.volta > r.volta)
+                    r.volta = f.volta;
+                r.desceu += f.desceu;
+                r.falsas += f.falsas;
+            }
+
+            if(tst_cenarios[i].rapida)
+                falhou = perdeu || r.subida > TST_SUBIDA || r.desceu;
+            else
+                falhou = r.subida >= 0;
+            if(ruido == 1 && (ficou || r.volta > TST_VOLTA || r.falsas))
+                falhou = 1;
+
+            printf("%-16s %4ux  %5.1fs  %9.1fs  %9u  %14u%s\n", tst_cenarios[i].nome, ruido,
+                   r.subida, r.volta, r.desceu, r.falsas, falhou ? "  FALHOU" : "");
+            if(falhou)
+                falhas++;
+        }
+    }
+
+    return falhas;
+}
+
+int main(void) {
+    const double convs[2] = {8000.0, 9300.0};
+    tst_resultado r;
+    unsigned char nivel, c, f;
+    int e;
+    unsigned int falhas = 0;
+
+    printf("Nível Erro   Conv    Leituras Dupl. Puladas Sem fase  Atraso máx  Consultas\n");
+    for(nivel = 0; nivel < 2; nivel++) {
+        for(e = -4; e <= 4; e++) {
+            for(c = 0; c < 2; c++) {
+                tst_resultado pior = {0};
+                double consultas = 0;
+
+                for(f = 0; f < TST_FASES; f++) {
+                    TST_Case(nivel, e * 0.005, convs[c], (f + 0.37) / TST_FASES, &r);
+                    pior.leituras += r.leituras;
+                    pior.duplicadas += r.duplicadas;
+                    pior.puladas += r.puladas;
+                    pior.fora += r.fora;
+                    pior.sem_fase += r.sem_fase;
+                    if(r.atraso_max > pior.atraso_max)
+                        pior.atraso_max = r.atraso_max;
+                    if(r.consultas > consultas)
+                        consultas = r.consultas;
+                }
+
+                printf("%-5u %+4.1f%% %4.1fms  %8u %5u %7u %8u  %7.2fms  %6.1f\n",
+                       nivel, e * 0.5, convs[c] / 1000, pior.leituras, pior.duplicadas,
+                       pior.puladas, pior.sem_fase, pior.atraso_max / 1000, consultas);
+                if(pior.duplicadas || pior.fora)
+                    falhas++;
+            }
+        }
+    }
+
+    falhas += TST_Derivatives();
+
+    printf(falhas ? "FALHOU: %u casos\n" : "OK\n", falhas);
+    return falhas != 0;
+}
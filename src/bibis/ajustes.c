@@ -0,0 +1,84 @@
+/******************************************************************************
+ * Biblioteca: Ajustes persistentes (ajustes.c)
+ * Autor: Elison Nogueira
+ * Data: 18/10/2026
+ * Versão: 1.0
+ * Plataforma: PIC18F25K50 (Microchip)
+ * Compilador: mikroC Pro for PIC v7.6.0
+ *
+ * Descrição:
+ * Leitura e gravação dos ajustes na EEPROM interna. Veja ajustes.h.
+ *
+ * Dependências:
+ * - Biblioteca EEPROM do mikroC PRO for PIC
+ ******************************************************************************/
+
+#include "ajustes.h"
+#include "bme280.h"
+#include "unidades.h"
+#include "adaptativo.h"
+
+ajustes_cfg ajustes;                                                            // Ajustes atuais
+
+// Grava um byte somente se ele mudou
+static void AJS_Put(unsigned int endereco, unsigned char valor) {
+    if(EEPROM_Read(endereco) == valor)
+        return;
+
+    EEPROM_Write(endereco, valor);
+    Delay_ms(20);                                                               // Intervalo exigido antes do próximo acesso
+}
+
+// Carrega os valores padrão (os mesmos da versão sem ajustes)
+void AJS_Defaults(void) {
+    ajustes.osrs_t = SAMPLING_X1;
+    ajustes.osrs_h = SAMPLING_X1;
+    ajustes.osrs_p = SAMPLING_X1;
+    ajustes.filtro = FILTER_OFF;
+    ajustes.un_temp = UN_CELSIUS;
+    ajustes.un_pres = UN_HPA;
+    ajustes.un_umid = UN_RELATIVA;
+    ajustes.nivel = ADPT_AUTOMATICO;
+    ajustes.luz = AJS_LUZ_PADRAO;
+    ajustes.orcamento = 0;                                                      // Só o comando WCET mede
+}
+
+// Lê os ajustes da EEPROM; retorna 0 e usa o padrão se o bloco for inválido
+unsigned char AJS_Load(void) {
+    unsigned char *p = (unsigned char *)&ajustes;
+    unsigned char i, soma;
+
+    if(EEPROM_Read(AJS_ENDERECO) != AJS_ASSINATURA) {
+        AJS_Defaults();
+        return 0;
+    }
+
+    soma = AJS_ASSINATURA;
+    for(i = 0; i < sizeof(ajustes_cfg); i++) {
+        p[i] = EEPROM_Read(AJS_ENDERECO + 1 + i);
+        soma += p[i];
+    }
+    soma += EEPROM_Read(AJS_ENDERECO + 1 + sizeof(ajustes_cfg));                // Bloco íntegro soma zero
+
+    if(soma != 0) {
+        AJS_Defaults();
+        return 0;
+    }
+
+    return 1;
+}
+
+// Grava os ajustes atuais na EEPROM
+void AJS_Save(void) {
+    unsigned char *p = (unsigned char *)&ajustes;
+    unsigned char i, soma;
+
+    soma = AJS_ASSINATURA;
+    for(i = 0; i < sizeof(ajustes_cfg); i++)
+        soma += p[i];
+
+    AJS_Put(AJS_ENDERECO, AJS_ASSINATURA);
+    for(i = 0; i < sizeof(ajustes_cfg); i++)
+        AJS_Put(AJS_ENDERECO + 1 + i, p[i]);
+    AJS_Put(AJS_ENDERECO + 1 + sizeof(ajustes_cfg), -soma);
+}
@@ -0,0 +1,58 @@
+/******************************************************************************
+ * Biblioteca: Ajustes persistentes (ajustes.h)
+ * Autor: Elison Nogueira
+ * Data: 18/10/2026
+ * Versão: 1.0
+ * Plataforma: PIC18F25K50 (Microchip)
+ * Compilador: mikroC Pro for PIC v7.6.0
+ *
+ * Descrição:
+ * Guarda na EEPROM interna a configuração de medição escolhida para a
+ * instalação (oversampling por canal, filtro IIR e nível de amostragem),
+ * as unidades de exibição, o tempo de backlight e o orçamento da
+ * compensação em tempo constante (pipeline.h). O bloco gravado é:
+ *
+ *   Endereço  Conteúdo
+ *   0         Assinatura (AJS_ASSINATURA)
+ *   1..n      Campos de ajustes_cfg
+ *   n+1       Soma de verificação (complemento de 2 da soma dos bytes 0..n)
+ *
+ * Com assinatura ou soma inválidas (EEPROM virgem, formato antigo ou
+ * gravação interrompida) AJS_Load carrega os valores padrão e retorna 0.
+ * AJS_Save só regrava os bytes que mudaram, poupando ciclos da EEPROM.
+ *
+ * Dependências:
+ * - Biblioteca EEPROM do mikroC PRO for PIC
+ *****************************************************************************/
+
+#ifndef AJUSTES_H
+#define AJUSTES_H
+
+#define AJS_ENDERECO      0x00                                                  // Endereço inicial na EEPROM
+#define AJS_ASSINATURA    0xA5                                                  // Muda quando o formato do bloco muda
+
+#define AJS_LUZ_PADRAO    30                                                    // Backlight apaga após 30s sem uso
+
+// Configuração persistida
+typedef struct {
+    unsigned char osrs_t;                                                       // Oversampling temperatura (bme280_sampling)
+    unsigned char osrs_h;                                                       // Oversampling umidade (bme280_sampling)
+    unsigned char osrs_p;                                                       // Oversampling pressão (bme280_sampling)
+    unsigned char filtro;                                                       // Filtro IIR (bme280_filter)
+    unsigned char un_temp;                                                      // Unidade de temperatura (unidades.h)
+    unsigned char un_pres;                                                      // Unidade de pressão
+    unsigned char un_umid;                                                      // Unidade de umidade
+    unsigned char nivel;                                                        // Nível fixo da amostragem ou ADPT_AUTOMATICO
+    unsigned char luz;                                                          // Segundos até apagar o backlight (0 = sempre aceso)
+    unsigned int orcamento;                                                     // Tempo constante da compensação (us, 0 = não medido)
+} ajustes_cfg;
+
+// Ajustes atuais em RAM
+extern ajustes_cfg ajustes;
+
+// Protótipos das funções
+unsigned char AJS_Load(void);                                                   // Lê da EEPROM (0 = inválido, usa padrão)
+void AJS_Save(void);                                                            // Grava na EEPROM
+void AJS_Defaults(void);                                                        // Carrega os valores padrão em RAM
+
+#endif
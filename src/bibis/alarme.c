@@ -0,0 +1,88 @@
+/******************************************************************************
+ * Biblioteca: Alarmes de limite (alarme.c)
+ * Autor: Elison Nogueira
+ * Data: 18/10/2026
+ * Versão: 1.0
+ * Plataforma: PIC18F25K50 (Microchip)
+ * Compilador: mikroC Pro for PIC v7.6.0
+ *
+ * Descrição:
+ * Motor de alarmes com limite, histerese, debounce e saídas digitais.
+ * Veja alarme.h para a análise de latência.
+ ******************************************************************************/
+
+#include "alarme.h"
+
+// Tabela padrão: habilitado, canal, tipo, limite, histerese, debounce, saída
+alarme_cfg alarmes[ALM_QTD] = {
+    {1, ALM_TEMPERATURA, ALM_ACIMA,  3500,  100,  2, 0x01, 0, 0},               // T > 35.00°C -> RA0
+    {1, ALM_TEMPERATURA, ALM_ABAIXO,  500,  100,  2, 0x02, 0, 0},               // T < 5.00°C -> RA1
+    {1, ALM_UMIDADE,     ALM_ACIMA, 81920, 5120,  2, 0x04, 0, 0},               // UR > 80% (histerese 5%) -> RA2
+    {0, ALM_PRESSAO,     ALM_ABAIXO, 98000, 200,  3, 0x08, 0, 0}                // P < 980hPa -> RA3 (desligado)
+};
+
+// Configura as saídas dos alarmes e zera os estados
+void ALM_Init(void) {
+    unsigned char i, mascara = 0;
+
+    for(i = 0; i < ALM_QTD; i++) {
+        mascara |= alarmes[i].saida;
+        alarmes[i].contador = 0;
+        alarmes[i].ativo = 0;
+    }
+
+    ANSELA &= ~mascara;                                                         // Pinos digitais
+    LATA &= ~mascara;                                                           // Saídas desligadas
+    TRISA &= ~mascara;                                                          // Pinos como saída
+}
+
+// Avalia todos os alarmes com a amostra recém compensada
+void ALM_Evaluate(long temp, unsigned long humi, unsigned long pres) {
+    unsigned char i, condicao;
+    long valor;
+    alarme_cfg *a;
+
+    for(i = 0; i < ALM_QTD; i++) {
+        a = &alarmes[i];
+        if(!a->habilitado)
+            continue;
+
+        switch(a->canal) {                                                      // Seleciona a grandeza
+            case ALM_TEMPERATURA: valor = temp; break;
+            case ALM_UMIDADE:     valor = (long)humi; break;
+            default:              valor = (long)pres; break;
+        }
+
+        if(!a->ativo) {                                                         // Condição de disparo
+            if(a->tipo == ALM_ACIMA) condicao = (valor > a->limite);
+            else                     condicao = (valor < a->limite);
+        } else {                                                                // Condição de rearme (com histerese)
+            if(a->tipo == ALM_ACIMA) condicao = (valor < a->limite - a->histerese);
+            else                     condicao = (valor > a->limite + a->histerese);
+        }
+
+        if(!condicao) {                                                         // Sequência interrompida
+            a->contador = 0;
+            continue;
+        }
+
+        if(++a->contador < a->debounce)
+            continue;
+
+        a->contador = 0;                                                        // Troca de estado confirmada
+        a->ativo = !a->ativo;
+        if(a->ativo) LATA |= a->saida;
+        else         LATA &= ~a->saida;
+    }
+}
+
+// Retorna os alarmes ativos (bit n = alarme n)
+unsigned char ALM_Status(void) {
+    unsigned char i, status = 0;
+
+    for(i = 0; i < ALM_QTD; i++)
+        if(alarmes[i].ativo)
+            status |= (1 << i);
+
+    return status;
+}
@@ -0,0 +1,92 @@
+/******************************************************************************
+ * Biblioteca: Alarmes de limite (alarme.h)
+ * Autor: Elison Nogueira
+ * Data: 18/10/2026
+ * Versão: 1.0
+ * Plataforma: PIC18F25K50 (Microchip)
+ * Compilador: mikroC Pro for PIC v7.6.0
+ *
+ * Descrição:
+ * Motor de alarmes configurável para acionar relés quando temperatura,
+ * umidade ou pressão cruzam um limite. Cada alarme possui:
+ * - Canal e sentido (acima ou abaixo do limite)
+ * - Histerese para rearme
+ * - Contagem de debounce (amostras consecutivas para disparar e rearmar)
+ * - Saída digital em PORTA (RA0..RA3)
+ *
+ * Os alarmes são avaliados logo após cada amostra, dentro do caminho de
+ * leitura (ALM_Evaluate), e não dependem da página exibida no display.
+ *
+ * Latência de pior caso:
+ * Um cruzamento que ocorre logo após uma leitura só é visto na leitura
+ * seguinte, e o disparo exige N leituras consecutivas. Com período de
+ * amostragem T, idade máxima do dado no sensor t_dado e N = debounce:
+ *
+ *   latência <= N * T + t_dado
+ *
+ * t_dado = t_medição + 2.2ms no modo normal, em que a leitura sai até 2.2ms
+ * após o fim da conversão (ADPT_Sync, adaptativo.h), e t_medição no modo
+ * forçado, com t_medição,max = 1.25 + 2.3*osrs_t + (2.3*osrs_p + 0.575) +
+ * (2.3*osrs_h + 0.575) ms (datasheet BME280, seção 9.1). O standby não
+ * entra: a conversão lida começa depois dele.
+ *
+ * Com a amostragem adaptativa (adaptativo.h) T depende do nível atual.
+ * Valores para x1/x1/x1 (t_medição = 9.3ms):
+ *
+ *   Nível  Modo                         T        t_dado     N=1       N=3
+ *   0      Normal, standby 62.5ms       0.282s   11.5ms     0.29s     0.86s
+ *   1      Normal, standby 500ms        1.016s   11.5ms     1.03s     3.06s
+ *   2      Forçado                      2s       9.3ms      2.01s     6.01s
+ *   3      Forçado                      10s      9.3ms      10.01s    30.01s
+ *
+ * O pior caso é o nível 3 (sensor estável há pelo menos 8 amostras). Uma
+ * variação rápida leva o controlador ao nível 0 já na amostra seguinte.
+ *
+ * Com a página Variômetro aberta o nível fica parado e a leitura ambiental
+ * roda a cada VAR_AMBIENTE sobre os brutos da última amostra de 16Hz
+ * (vario.h): t_dado = VAR_PERIODO + t_medição + t_standby.
+ *
+ *   Modo                         T        t_dado     N=1       N=3
+ *   Variômetro (P x8, T/UR x1)   2s       88.4ms     2.09s     6.09s
+ *****************************************************************************/
+
+#ifndef ALARME_H
+#define ALARME_H
+
+#define ALM_QTD           4                                                     // Número de alarmes
+
+// Canais monitorados
+typedef enum {
+    ALM_TEMPERATURA = 0,                                                        // Centésimos de °C
+    ALM_UMIDADE     = 1,                                                        // Passos de 1/1024 %
+    ALM_PRESSAO     = 2                                                         // Pa
+} alarme_canal;
+
+// Sentido do limite
+typedef enum {
+    ALM_ACIMA  = 0,                                                             // Dispara quando valor > limite
+    ALM_ABAIXO = 1                                                              // Dispara quando valor < limite
+} alarme_tipo;
+
+// Configuração e estado de um alarme
+typedef struct {
+    unsigned char habilitado;                                                   // 0 = ignorado
+    alarme_canal canal;                                                         // Grandeza monitorada
+    alarme_tipo tipo;                                                           // Acima ou abaixo
+    long limite;                                                                // Limite na unidade do canal
+    long histerese;                                                             // Margem para rearme
+    unsigned char debounce;                                                     // Amostras consecutivas (>= 1)
+    unsigned char saida;                                                        // Bit em LATA (0 = sem saída)
+    unsigned char contador;                                                     // Amostras consecutivas na condição
+    unsigned char ativo;                                                        // 1 = alarme disparado
+} alarme_cfg;
+
+// Tabela de alarmes (pode ser alterada em tempo de execução)
+extern alarme_cfg alarmes[ALM_QTD];
+
+// Protótipos das funções
+void ALM_Init(void);                                                            // Configura as saídas e zera os estados
+void ALM_Evaluate(long temp, unsigned long humi, unsigned long pres);           // Avalia todos os alarmes
+unsigned char ALM_Status(void);                                                 // Bit n = alarme n ativo
+
+#endif
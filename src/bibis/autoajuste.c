@@ -0,0 +1,125 @@
+/******************************************************************************
+ * Biblioteca: Auto-ajuste de oversampling (autoajuste.c)
+ * Autor: Elison Nogueira
+ * Data: 18/10/2026
+ * Versão: 1.0
+ * Plataforma: PIC18F25K50 (Microchip)
+ * Compilador: mikroC Pro for PIC v7.6.0
+ *
+ * Descrição:
+ * Medição de ruído por combinação de oversampling/filtro e escolha da
+ * configuração mais barata. Veja autoajuste.h.
+ ******************************************************************************/
+
+#include "autoajuste.h"
+#include "bme280.h"
+
+#define TUNE_CANAIS       3                                                     // T, UR e P
+#define TUNE_DESVIO_MAX   2047                                                  // Limite de |x - x0| (evita estouro)
+
+const unsigned int tune_alvo[TUNE_CANAIS] = {TUNE_ALVO_T, TUNE_ALVO_H, TUNE_ALVO_P};
+
+// Mede o ruído de uma combinação; bit n do retorno = canal n atingiu o alvo
+static unsigned char TUNE_Measure(unsigned char osrs, unsigned char filtro) {
+    long base[TUNE_CANAIS], soma[TUNE_CANAIS], d;
+    unsigned long quad[TUNE_CANAIS], limite;
+    long v[TUNE_CANAIS];
+    unsigned char i, c, ok;
+
+    BME280_Configure(MODE_SLEEP, osrs, osrs, osrs, filtro, BME280_cfg.standby);
+
+    for(i = 0; i < (2 << filtro); i++) {                                        // Acomodação do filtro IIR
+        BME280_ForcedMeasurement();
+        BME280_Update();
+    }
+
+    for(i = 0; i < TUNE_AMOSTRAS; i++) {
+        BME280_ForcedMeasurement();
+        BME280_Update();
+        v[0] = adc_T;
+        v[1] = adc_H;
+        v[2] = adc_P;
+
+        for(c = 0; c < TUNE_CANAIS; c++) {
+            if(i == 0) {                                                        // Primeira leitura é a referência
+                base[c] = v[c];
+                soma[c] = 0;
+                quad[c] = 0;
+            }
+            d = v[c] - base[c];
+            if(d > TUNE_DESVIO_MAX) d = TUNE_DESVIO_MAX;
+            if(d < -TUNE_DESVIO_MAX) d = -TUNE_DESVIO_MAX;
+            soma[c] += d;
+            quad[c] += (unsigned long)(d * d);
+        }
+    }
+
+    // N²·variância = N*soma(d²) - soma(d)²; compara com N²*alvo² sem divisão
+    ok = 0;
+    for(c = 0; c < TUNE_CANAIS; c++) {
+        limite = (unsigned long)tune_alvo[c] * tune_alvo[c] * (TUNE_AMOSTRAS * TUNE_AMOSTRAS);
+        if(quad[c] * TUNE_AMOSTRAS - (unsigned long)(soma[c] * soma[c]) <= limite)
+            ok |= 1 << c;
+    }
+
+    return ok;
+}
+
+// Procura a configuração mais barata que atinge o ruído alvo e a aplica
+unsigned char TUNE_Run(void) {
+    bme280_mode modo;
+    unsigned char escolha[TUNE_CANAIS], melhor[TUNE_CANAIS];
+    unsigned char filtro, melhor_filtro, osrs, ok, pendentes, c, atingidos, melhor_atingidos;
+    unsigned long custo, melhor_custo;
+
+    modo = BME280_cfg.mode;                                                     // Restaurado ao final
+
+    melhor_atingidos = 0;
+    melhor_custo = 0xFFFFFFFF;
+    melhor_filtro = FILTER_OFF;
+    for(c = 0; c < TUNE_CANAIS; c++)
+        melhor[c] = SAMPLING_X16;
+
+    for(filtro = FILTER_OFF; filtro <= TUNE_FILTRO_MAX; filtro++) {
+        pendentes = 0x07;
+        for(osrs = SAMPLING_X1; osrs <= SAMPLING_X16 && pendentes; osrs++) {
+            ok = TUNE_Measure(osrs, filtro) & pendentes;
+            for(c = 0; c < TUNE_CANAIS; c++)
+                if(ok & (1 << c))
+                    escolha[c] = osrs;                                          // Menor oversampling que atinge o alvo
+            pendentes &= ~ok;
+        }
+
+        atingidos = 0;
+        for(c = 0; c < TUNE_CANAIS; c++) {
+            if(pendentes & (1 << c))
+                escolha[c] = SAMPLING_X16;                                      // Alvo inatingível: usa o máximo
+            else
+                atingidos++;
+        }
+
+        custo = BME280_MeasTime(escolha[0], escolha[1], escolha[2]);
+        if(atingidos > melhor_atingidos ||
+           (atingidos == melhor_atingidos && custo < melhor_custo)) {
+            melhor_atingidos = atingidos;
+            melhor_custo = custo;
+            melhor_filtro = filtro;
+            for(c = 0; c < TUNE_CANAIS; c++)
+                melhor[c] = escolha[c];
+        }
+
+        if(atingidos == TUNE_CANAIS &&
+           custo == BME280_MeasTime(SAMPLING_X1, SAMPLING_X1, SAMPLING_X1))
+            break;                                                              // Já é o mínimo possível
+    }
+
+    BME280_Configure(modo, melhor[0], melhor[1], melhor[2],
+                     melhor_filtro, BME280_cfg.standby);
+
+    return melhor_atingidos == TUNE_CANAIS;
+}
+
+// Retorna o tempo de conversão máximo da configuração atual em µs
+unsigned long TUNE_Time(void) {
+    return BME280_MeasTime(BME280_cfg.T_sampling, BME280_cfg.H_sampling, BME280_cfg.P_sampling);
+}
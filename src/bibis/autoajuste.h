@@ -0,0 +1,50 @@
+/******************************************************************************
+ * Biblioteca: Auto-ajuste de oversampling (autoajuste.h)
+ * Autor: Elison Nogueira
+ * Data: 18/10/2026
+ * Versão: 1.0
+ * Plataforma: PIC18F25K50 (Microchip)
+ * Compilador: mikroC Pro for PIC v7.6.0
+ *
+ * Descrição:
+ * Escolhe, no comissionamento, a configuração de oversampling e filtro IIR
+ * mais barata que atinge o ruído alvo de cada canal no local instalado.
+ *
+ * Para cada filtro de FILTER_OFF até TUNE_FILTRO_MAX o oversampling é
+ * aumentado de x1 a x16 (os três canais juntos, em modo forçado). Em cada
+ * combinação são descartadas as amostras de acomodação do filtro e medida a
+ * variância de TUNE_AMOSTRAS leituras brutas de cada canal. Cada canal fica
+ * com o menor oversampling que atinge seu alvo; entre os filtros vence o de
+ * menor tempo de conversão (que define também a corrente média do sensor),
+ * e em empate o de menor coeficiente, que responde mais rápido.
+ *
+ * Tempo de conversão (datasheet BME280, seção 9.1):
+ *   t_medição,max = 1.25 + 2.3*osrs_t + (2.3*osrs_p + 0.575) +
+ *                   (2.3*osrs_h + 0.575) ms
+ * O filtro não altera o tempo de conversão, apenas o tempo de resposta, por
+ * isso é limitado por TUNE_FILTRO_MAX. O filtro não atua na umidade.
+ *
+ * O ruído é medido nos valores brutos do ADC (escala de 20 bits para T e P,
+ * 16 bits para UR), que são comparáveis entre resoluções diferentes; a
+ * quantização de 16 bits de x1 sem filtro entra na variância medida.
+ *
+ * A rotina bloqueia por alguns segundos (até ~15s com TUNE_FILTRO_MAX =
+ * FILTER_4) e deve ser chamada antes do laço principal.
+ *****************************************************************************/
+
+#ifndef AUTOAJUSTE_H
+#define AUTOAJUSTE_H
+
+#define TUNE_AMOSTRAS     16                                                    // Leituras por combinação (potência de 2)
+#define TUNE_FILTRO_MAX   FILTER_4                                              // Maior filtro aceito (resposta em ~5 amostras)
+
+// Ruído alvo (desvio padrão em LSB do ADC)
+#define TUNE_ALVO_T       16                                                    // ~0.005°C
+#define TUNE_ALVO_H       3                                                     // ~0.024%UR
+#define TUNE_ALVO_P       4                                                     // ~0.7Pa
+
+// Protótipos das funções
+unsigned char TUNE_Run(void);                                                   // Ajusta e aplica (1 = todos os alvos atingidos)
+unsigned long TUNE_Time(void);                                                  // Tempo de conversão atual em µs
+
+#endif
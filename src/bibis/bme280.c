@@ -2,55 +2,120 @@
  * Biblioteca: Driver BME280 (bme280.c)
  * Autor: Elison Nogueira
  * Data: 16/11/2024
- * Verso: 1.0
+ * Versão: 1.0
  * Plataforma: PIC18F25K50 (Microchip)
  * Compilador: mikroC Pro for PIC v7.6.0
  *
- * Descrio:
+ * Descrição:
  * Driver para sensor BME280 da Bosch que realiza leituras de temperatura,
- * umidade e presso atmosfrica via interface I2C. O driver suporta:
- * - Modo normal, forado e sleep
- * - Configurao de oversampling para temp/presso/umidade
- * - Filtro digital configurvel
- * - Tempo de standby ajustvel
+ * umidade e pressão atmosférica via interface I2C. O driver suporta:
+ * - Modo normal, forçado e sleep
+ * - Configuração de oversampling para temp/pressão/umidade
+ * - Filtro digital configurável
+ * - Tempo de standby ajustável
+ * - Indicação de conversão nova ou repetida a cada leitura
  *
- * Dependncias:
+ * Os registradores de dados ficam congelados (shadowing) durante a leitura
+ * em rajada, então cada leitura é coerente, mas pode repetir a conversão
+ * anterior. BME280_Update classifica cada leitura:
+ *
+ *   Evidência de conversão desde a leitura anterior   Brutos   Leitura
+ *   Sim (forçada, measuring visto, ciclo decorrido)   -        Nova
+ *   Não                                               Mudaram  Nova
+ *   Não                                               Iguais   Repetida
+ *
+ * O ciclo decorrido é informado por quem controla o tempo (RTC) com
+ * BME280_MarkConversion. Leituras repetidas não devem ser agregadas de
+ * novo; BME280_NewCount dá a taxa efetiva de amostras.
+ *
+ * Na compensação, toda multiplicação por um coeficiente de calibração usa
+ * as rotinas 32x16 de mult.h, e os quadrados e o produto por dig_P1 usam a
+ * 16x16 quando a análise de faixas (tabela antes de ReadTemperature) mostra
+ * que o fator cabe em 16 bits. O produto de dois fatores de 17 bits da
+ * umidade segue no long * long do compilador.
+ *
+ * A compensação é preguiçosa: BME280_Update só lê os brutos e marca como
+ * sujo cada canal cujo bruto mudou (a temperatura suja os três, por causa
+ * de t_fine). ReadTemperature, ReadHumidity e ReadPressure compensam só o
+ * canal pedido e só se estiver sujo; senão devolvem o último valor. Uma
+ * leitura repetida custa apenas a rajada I2C.
+ *
+ * Na pressão, var2 e o divisor var1 só dependem de t_fine e da calibração:
+ * ficam guardados enquanto t_fine não muda, e o recíproco do divisor só é
+ * refeito quando o divisor muda. Cada amostra troca a divisão 32/32 por
+ * uma multiplicação pela parte alta (MUL_High32) e uma correção:
+ *
+ *   m = floor(2^32 / d)    q' = floor(n * m / 2^32)    q' = q ou q - 1
+ *   r = n - q' * d;  se r >= d, q' + 1
+ *
+ * m * d fica entre 2^32 - d e 2^32, então o erro de q' é menor que 1 e
+ * uma única correção dá sempre o mesmo quociente da divisão.
+ *
+ * bme280_teste.c (teste_host.py) confere BME280_Divide contra n / d e a compensação,
+ * inteira e sob demanda, contra a fórmula original em todo o ADC.
+ *
+ * Dependências:
  * - Biblioteca I2C do mikroC PRO for PIC
+ * - Multiplicações 32x16 (mult.h)
  *
- * Limitaes:
- * - Apenas comunicao I2C (no suporta SPI)
- * - Preciso de temperatura: 0.01C
- * - Preciso de umidade: 0.008%
- * - Preciso de presso: 0.18Pa
+ * Limitações:
+ * - Apenas comunicação I2C (não suporta SPI)
+ * - Precisão de temperatura: 0.01°C
+ * - Precisão de umidade: 0.008%
+ * - Precisão de pressão: 0.18Pa
  ******************************************************************************/
 
 #include "bme280.h"
+#include "mult.h"
 
-// Variveis para armazenamento das leituras e calibrao
+// Variáveis para armazenamento das leituras e calibração
 long adc_T, adc_P, adc_H, t_fine;                                               // Dados brutos do ADC
-calib_bme280 BME280_calib;                                                      // Dados de calibrao
-unsigned char ADD_BME280;                                                       // Endereo I2C do BME280
+calib_bme280 BME280_calib;                                                      // Dados de calibração
+config_bme280 BME280_cfg;                                                       // Configuração atual
+unsigned char ADD_BME280;                                                       // Endereço I2C do BME280
+
+// Controle de conversões novas (veja BME280_Fresh)
+unsigned char bme280_conversao;                                                 // 1 = há evidência de conversão desde a última leitura
+unsigned char bme280_nova;                                                      // 1 = a última leitura trouxe conversão nova
+unsigned int bme280_novas, bme280_repetidas;                                    // Contadores de leituras (dão a volta em 65536)
+long bme280_ant_T, bme280_ant_P, bme280_ant_H;                                  // Valores brutos da leitura anterior
+
+// Canais compensados sob demanda (veja ReadTemperature)
+unsigned char bme280_sujos;                                                     // BME280_CANAL_* com bruto novo ainda não compensado
+long bme280_temp;                                                               // Última temperatura compensada
+unsigned long bme280_umid, bme280_pres;                                         // Última umidade e pressão compensadas
+unsigned char bme280_pres_ok;                                                   // 0 = calibração dá divisor zero
+
+// Parte da pressão que só depende de t_fine (veja ReadPressure)
+unsigned char bme280_p_valido;                                                  // 0 = recalcular (calibração nova)
+long bme280_p_tfine;                                                            // t_fine do cálculo guardado
+long bme280_p_var2;                                                             // var2 / 4096
+unsigned long bme280_p_div;                                                     // Divisor (var1); 0 = pressão inválida
+unsigned long bme280_p_inv;                                                     // floor(2^32 / bme280_p_div)
+
+// Duração de cada código de standby em µs (ordem de standby_time)
+const unsigned long bme280_standby_us[8] = {500, 62500, 125000, 250000, 500000, 1000000, 10000, 20000};
 
 // Escrita de um byte no registrador do BME280 via I2C
 void I2C_Write8(unsigned short reg_addr, unsigned short _data) {
-    I2C_Start();                                                                // Incio comunicao I2C
-    I2C_Write(ADD_BME280);                                                      // Endereo do BME280
+    I2C_Start();                                                                // Início comunicação I2C
+    I2C_Write(ADD_BME280);                                                      // Endereço do BME280
     I2C_Write(reg_addr);                                                        // Registrador a ser acessado
     I2C_Write(_data);                                                           // Dado a ser gravado
-    I2C_Stop();                                                                 // Fim comunicao I2C
+    I2C_Stop();                                                                 // Fim comunicação I2C
 }
 
 // Leitura de um byte do registrador do BME280 via I2C
 unsigned short I2C_Read8(unsigned short reg_addr) {
     unsigned short ret;                                                         // Armazena byte lido
 
-    I2C_Start();                                                                // Incio comunicao I2C
-    I2C_Write(ADD_BME280);                                                      // Endereo do BME280
+    I2C_Start();                                                                // Início comunicação I2C
+    I2C_Write(ADD_BME280);                                                      // Endereço do BME280
     I2C_Write(reg_addr);                                                        // Registrador a ser lido
-    I2C_Restart();                                                              // Reinicia comunicao
+    I2C_Restart();                                                              // Reinicia comunicação
     I2C_Write(ADD_BME280 | 1);                                                  // Modo leitura
-    ret = I2C_Read(0);                                                          // L byte
-    I2C_Stop();                                                                 // Fim comunicao I2C
+    ret = I2C_Read(0);                                                          // Lê byte
+    I2C_Stop();                                                                 // Fim comunicação I2C
 
     return ret;                                                                 // Retorna byte lido
 }
@@ -62,39 +127,39 @@ unsigned int I2C_Read16(unsigned short reg_addr) {
         unsigned int w;                                                         // Palavra de 16 bits
     } ret;
 
-    I2C_Start();                                                                // Incio comunicao I2C
-    I2C_Write(ADD_BME280);                                                      // Endereo do BME280
+    I2C_Start();                                                                // Início comunicação I2C
+    I2C_Write(ADD_BME280);                                                      // Endereço do BME280
     I2C_Write(reg_addr);                                                        // Registrador a ser lido
-    I2C_Restart();                                                              // Reinicia comunicao
+    I2C_Restart();                                                              // Reinicia comunicação
     I2C_Write(ADD_BME280 | 1);                                                  // Modo leitura
-    ret.b[0] = I2C_Read(1);                                                     // L byte menos significativo
-    ret.b[1] = I2C_Read(0);                                                     // L byte mais significativo
-    I2C_Stop();                                                                 // Fim comunicao I2C
+    ret.b[0] = I2C_Read(1);                                                     // Lê byte menos significativo
+    ret.b[1] = I2C_Read(0);                                                     // Lê byte mais significativo
+    I2C_Stop();                                                                 // Fim comunicação I2C
 
     return(ret.w);                                                              // Retorna palavra lida
 }
 
-// Testa conexo com o sensor buscando endereo I2C vlido
+// Testa conexão com o sensor buscando endereço I2C válido
 unsigned char BME280_TestConnection(void) {
     unsigned char i;
     unsigned char found = 0;
 
-    for(i = 0; i < 2; i++) {                                                    // Testa os dois endereos possveis
-        I2C1_Start();                                                           // Inicia comunicao
+    for(i = 0; i < 2; i++) {                                                    // Testa os dois endereços possíveis
+        I2C1_Start();                                                           // Inicia comunicação
         if(i == 0) {
-            if(I2C1_Wr(BME280_ADDR_LOW) == 0) found = BME280_ADDR_LOW;          // Testa endereo 0x76
+            if(I2C1_Wr(BME280_ADDR_LOW) == 0) found = BME280_ADDR_LOW;          // Testa endereço 0x76
         } else {
-            if(I2C1_Wr(BME280_ADDR_HIGH) == 0) found = BME280_ADDR_HIGH;        // Testa endereo 0x77
+            if(I2C1_Wr(BME280_ADDR_HIGH) == 0) found = BME280_ADDR_HIGH;        // Testa endereço 0x77
         }
-        I2C1_Stop();                                                            // Finaliza comunicao
+        I2C1_Stop();                                                            // Finaliza comunicação
 
-        if(found) break;                                                        // Endereo encontrado
+        if(found) break;                                                        // Endereço encontrado
     }
 
-    return found;                                                               // Retorna endereo encontrado
+    return found;                                                               // Retorna endereço encontrado
 }
 
-// Configura os parmetros de operao do BME280
+// Configura os parâmetros de operação do BME280
 void BME280_Configure(bme280_mode mode, bme280_sampling T_sampling,
                      bme280_sampling H_sampling, bme280_sampling P_sampling,
                      bme280_filter filter, standby_time standby) {
@@ -103,33 +168,41 @@ void BME280_Configure(bme280_mode mode, bme280_sampling T_sampling,
 
     _ctrl_hum = H_sampling;                                                     // Configura amostragem umidade
     _config = ((standby << 5) | (filter << 2)) & 0xFC;                          // Configura standby e filtro
-    _ctrl_meas = (T_sampling << 5) | (P_sampling << 2) | mode;                  // Configura amostragem T/P e modo
+    _ctrl_meas = (unsigned short)((T_sampling << 5) | (P_sampling << 2) | mode); // Configura amostragem T/P e modo
+
+    BME280_cfg.mode = mode;                                                     // Guarda a configuração aplicada
+    BME280_cfg.T_sampling = T_sampling;
+    BME280_cfg.H_sampling = H_sampling;
+    BME280_cfg.P_sampling = P_sampling;
+    BME280_cfg.filter = filter;
+    BME280_cfg.standby = standby;
 
+    I2C_Write8(BME280_REG_CONTROL, _ctrl_meas & 0xFC);                          // Sleep: config é ignorada em modo normal
     I2C_Write8(BME280_REG_CTRLHUM, _ctrl_hum);                                  // Grava config umidade
     I2C_Write8(BME280_REG_CONFIG, _config);                                     // Grava config geral
-    I2C_Write8(BME280_REG_CONTROL, _ctrl_meas);                                 // Grava config medio
+    I2C_Write8(BME280_REG_CONTROL, _ctrl_meas);                                 // Grava config medição
 }
 
-// Inicializa o sensor BME280 com os parmetros fornecidos
+// Inicializa o sensor BME280 com os parâmetros fornecidos
 unsigned short BME280_begin(bme280_mode mode, bme280_sampling T_sampling,
                           bme280_sampling H_sampling, bme280_sampling P_sampling,
                           bme280_filter filter, standby_time standby) {
 
     if(I2C_Read8(BME280_REG_CHIPID) != BME280_CHIP_ID)                          // Verifica ID do sensor
-        return 0;                                                               // Retorna erro se ID invlido
+        return 0;                                                               // Retorna erro se ID inválido
 
     I2C_Write8(BME280_REG_SOFTRESET, 0xB6);                                     // Executa reset do sensor
     delay_ms(100);                                                              // Aguarda reset completar
 
-    while((I2C_Read8(BME280_REG_STATUS) & 0x01) == 0x01)                        // Aguarda dados de calibrao
+    while((I2C_Read8(BME280_REG_STATUS) & 0x01) == 0x01)                        // Aguarda dados de calibração
         delay_ms(100);
 
-    // L coeficientes de calibrao para temperatura
+    // Lê coeficientes de calibração para temperatura
     BME280_calib.dig_T1 = I2C_Read16(BME280_REG_DIG_T1);                        // Coeficiente T1
     BME280_calib.dig_T2 = I2C_Read16(BME280_REG_DIG_T2);                        // Coeficiente T2
     BME280_calib.dig_T3 = I2C_Read16(BME280_REG_DIG_T3);                        // Coeficiente T3
 
-    // L coeficientes de calibrao para presso
+    // Lê coeficientes de calibração para pressão
     BME280_calib.dig_P1 = I2C_Read16(BME280_REG_DIG_P1);                        // Coeficiente P1
     BME280_calib.dig_P2 = I2C_Read16(BME280_REG_DIG_P2);                        // Coeficiente P2
     BME280_calib.dig_P3 = I2C_Read16(BME280_REG_DIG_P3);                        // Coeficiente P3
@@ -140,44 +213,109 @@ unsigned short BME280_begin(bme280_mode mode, bme280_sampling T_sampling,
     BME280_calib.dig_P8 = I2C_Read16(BME280_REG_DIG_P8);                        // Coeficiente P8
     BME280_calib.dig_P9 = I2C_Read16(BME280_REG_DIG_P9);                        // Coeficiente P9
 
-    // L coeficientes de calibrao para umidade
+    // Lê coeficientes de calibração para umidade
     BME280_calib.dig_H1 = I2C_Read8(BME280_REG_DIG_H1);                         // Coeficiente H1
     BME280_calib.dig_H2 = I2C_Read16(BME280_REG_DIG_H2);                        // Coeficiente H2
     BME280_calib.dig_H3 = I2C_Read8(BME280_REG_DIG_H3);                         // Coeficiente H3
 
-    // L coeficientes H4 e H5 que possuem bits compartilhados
+    // Lê coeficientes H4 e H5 que possuem bits compartilhados
     BME280_calib.dig_H4 = ((unsigned int)I2C_Read8(BME280_REG_DIG_H4) << 4) |
                           (I2C_Read8(BME280_REG_DIG_H4 + 1) & 0x0F);            // Coeficiente H4
     if (BME280_calib.dig_H4 & 0x0800)                                           // Ajusta sinal se negativo
-        BME280_calib.dig_H4 |= 0xF000;
+        BME280_calib.dig_H4 |= (int)0xF000;
 
     BME280_calib.dig_H5 = ((unsigned int)I2C_Read8(BME280_REG_DIG_H5 + 1) << 4) |
                           (I2C_Read8(BME280_REG_DIG_H5) >> 4);                  // Coeficiente H5
     if (BME280_calib.dig_H5 & 0x0800)                                           // Ajusta sinal se negativo
-        BME280_calib.dig_H5 |= 0xF000;
+        BME280_calib.dig_H5 |= (int)0xF000;
 
     BME280_calib.dig_H6 = I2C_Read8(BME280_REG_DIG_H6);                         // Coeficiente H6
 
-    BME280_Configure(mode, T_sampling, H_sampling, P_sampling, filter, standby);// Configura parmetros
+    BME280_Invalidate(BME280_CANAL_T | BME280_CANAL_H | BME280_CANAL_P | BME280_CALIBRACAO);
+
+    BME280_Configure(mode, T_sampling, H_sampling, P_sampling, filter, standby);// Configura parâmetros
 
     return 1;                                                                   // Retorna sucesso
 }
 
-// Fora uma nova medio quando em modo forado
+// Força uma nova medição quando em modo forçado
 unsigned short BME280_ForcedMeasurement() {
-    unsigned short ctrl_meas_reg = I2C_Read8(BME280_REG_CONTROL);               // L registrador controle
+    unsigned short ctrl_meas_reg = I2C_Read8(BME280_REG_CONTROL);               // Lê registrador controle
 
-    if ((ctrl_meas_reg & 0x03) != 0x00)                                         // Verifica se est em sleep
-        return 0;                                                               // Retorna erro se no
+    if ((ctrl_meas_reg & 0x03) != 0x00)                                         // Verifica se está em sleep
+        return 0;                                                               // Retorna erro se não
 
-    I2C_Write8(BME280_REG_CONTROL, ctrl_meas_reg | 1);                          // Fora uma medio
-    while (I2C_Read8(BME280_REG_STATUS) & 0x08)                                 // Aguarda medio completar
+    I2C_Write8(BME280_REG_CONTROL, ctrl_meas_reg | 1);                          // Força uma medição
+    while (I2C_Read8(BME280_REG_STATUS) & 0x08)                                 // Aguarda medição completar
         delay_ms(1);
+    bme280_conversao = 1;                                                       // A próxima leitura é nova
 
     return 1;                                                                   // Retorna sucesso
 }
 
-// Atualiza leituras brutas de presso, temperatura e umidade
+// Converte o código de oversampling em número de amostras (x1..x16)
+static unsigned char BME280_Factor(unsigned char osrs) {
+    if(osrs == SAMPLING_SKIPPED)
+        return 0;
+
+    return 1 << (osrs - 1);
+}
+
+// Tempo de conversão em µs: base + passo por amostra + extra por canal P/UR ligado
+static unsigned long BME280_Time(unsigned char osrs_t, unsigned char osrs_h, unsigned char osrs_p,
+                                 unsigned int base, unsigned int passo, unsigned int extra) {
+    unsigned long t;
+
+    t = base + passo * (unsigned long)BME280_Factor(osrs_t);
+    if(osrs_p != SAMPLING_SKIPPED)
+        t += passo * (unsigned long)BME280_Factor(osrs_p) + extra;
+    if(osrs_h != SAMPLING_SKIPPED)
+        t += passo * (unsigned long)BME280_Factor(osrs_h) + extra;
+
+    return t;
+}
+
+// Tempo de conversão máximo em µs para os oversamplings dados (datasheet, seção 9.1)
+unsigned long BME280_MeasTime(unsigned char osrs_t, unsigned char osrs_h, unsigned char osrs_p) {
+    return BME280_Time(osrs_t, osrs_h, osrs_p, 1250, 2300, 575);
+}
+
+// Período do modo normal em µs com a configuração atual (conversão típica + standby)
+unsigned long BME280_NormalPeriod(void) {
+    return BME280_Time(BME280_cfg.T_sampling, BME280_cfg.H_sampling, BME280_cfg.P_sampling, 1000, 2000, 500) +
+           bme280_standby_us[BME280_cfg.standby];
+}
+
+// Retorna 1 enquanto uma conversão está em andamento (bit measuring do status)
+unsigned char BME280_Measuring(void) {
+    if((I2C_Read8(BME280_REG_STATUS) & 0x08) == 0)
+        return 0;
+
+    bme280_conversao = 1;                                                       // Ao terminar, os registradores mudam
+    return 1;
+}
+
+// Informa que passou pelo menos um ciclo do modo normal desde a última leitura
+void BME280_MarkConversion(void) {
+    bme280_conversao = 1;
+}
+
+// Retorna 1 se a última leitura (BME280_Update) trouxe uma conversão nova
+unsigned char BME280_Fresh(void) {
+    return bme280_nova;
+}
+
+// Leituras com conversão nova desde a inicialização (módulo 65536)
+unsigned int BME280_NewCount(void) {
+    return bme280_novas;
+}
+
+// Leituras que repetiram a conversão anterior desde a inicialização (módulo 65536)
+unsigned int BME280_RepeatCount(void) {
+    return bme280_repetidas;
+}
+
+// Atualiza leituras brutas de pressão, temperatura e umidade
 void BME280_Update() {
     union {
         unsigned short b[4];                                                    // Array de bytes
@@ -185,109 +323,297 @@ void BME280_Update() {
     } ret;
     ret.b[3] = 0x00;                                                            // Limpa byte mais significativo
 
-    I2C_Start();                                                                // Inicia comunicao
-    I2C_Write(ADD_BME280);                                                      // Endereo do sensor
+    I2C_Start();                                                                // Inicia comunicação
+    I2C_Write(ADD_BME280);                                                      // Endereço do sensor
     I2C_Write(BME280_REG_PRESS_MSB);                                            // Registrador inicial
     I2C_Restart();                                                              // Reinicia para leitura
     I2C_Write(ADD_BME280 | 1);                                                  // Modo leitura
 
-    // L presso (20 bits)
+    // Lê pressão (20 bits)
     ret.b[2] = I2C_Read(1);                                                     // Byte mais significativo
     ret.b[1] = I2C_Read(1);                                                     // Byte do meio
     ret.b[0] = I2C_Read(1);                                                     // Byte menos significativo
-    adc_P = (ret.dw >> 4) & 0xFFFFF;                                            // Extrai 20 bits presso
+    adc_P = (ret.dw >> 4) & 0xFFFFF;                                            // Extrai 20 bits pressão
 
-    // L temperatura (20 bits)
+    // Lê temperatura (20 bits)
     ret.b[2] = I2C_Read(1);                                                     // Byte mais significativo
     ret.b[1] = I2C_Read(1);                                                     // Byte do meio
     ret.b[0] = I2C_Read(1);                                                     // Byte menos significativo
     adc_T = (ret.dw >> 4) & 0xFFFFF;                                            // Extrai 20 bits temperatura
 
-    // L umidade (16 bits)
-    ret.b[2] = 0x00;                                                            // Limpa byte no usado
+    // Lê umidade (16 bits)
+    ret.b[2] = 0x00;                                                            // Limpa byte não usado
     ret.b[1] = I2C_Read(1);                                                     // Byte mais significativo
     ret.b[0] = I2C_Read(0);                                                     // Byte menos significativo
-    I2C_Stop();                                                                 // Finaliza comunicao
+    I2C_Stop();                                                                 // Finaliza comunicação
 
     adc_H = ret.dw & 0xFFFF;                                                    // Extrai 16 bits umidade
+
+    // Nova se houve evidência de conversão ou se algum valor bruto mudou
+    bme280_nova = bme280_conversao ||
+                  adc_T != bme280_ant_T || adc_P != bme280_ant_P || adc_H != bme280_ant_H;
+    if(bme280_nova)
+        bme280_novas++;
+    else
+        bme280_repetidas++;
+
+    // Só o canal cujo bruto mudou precisa de compensação; t_fine entra nos três
+    if(adc_T != bme280_ant_T)
+        bme280_sujos = BME280_CANAL_T | BME280_CANAL_H | BME280_CANAL_P;
+    if(adc_H != bme280_ant_H)
+        bme280_sujos |= BME280_CANAL_H;
+    if(adc_P != bme280_ant_P)
+        bme280_sujos |= BME280_CANAL_P;
+
+    bme280_conversao = 0;
+    bme280_ant_T = adc_T;
+    bme280_ant_P = adc_P;
+    bme280_ant_H = adc_H;
 }
 
-// L temperatura em centsimos de grau Celsius
-unsigned short ReadTemperature(long *temp) {
-    long var1, var2;                                                            // Variveis auxiliares clculo
+// Faixas dos intermediários da compensação, geradas por bme280_faixas.py
+// (coeficientes em toda a faixa do tipo, brutos em toda a faixa do ADC,
+// t_fine e a pressão final na faixa de operação do sensor). O mikroC não tem
+// tipo de 24 bits: só o que cabe em 16 bits (marca 16) muda de rotina, e
+// sempre com teste do módulo, para valer também fora da faixa. A marca !
+// indica um passo que estoura 32 bits com coeficientes quaisquer, herdado
+// da fórmula da Bosch, que conta com os coeficientes reais do sensor. Cada
+// produto aparece antes da divisão que o segue, onde o estouro acontece.
+//
+//   Passo                                    Mínimo .. Máximo         Bits
+//   T  adc_T/8 - 2*dig_T1                   -131070 .. 131071         18
+//   T  a*dig_T2                         -4294934528 .. 4294901760     33  !
+//   T  var1 = a*dig_T2/2048                -2097136 .. 2097120        22
+//   T  adc_T/16 - dig_T1                     -65535 .. 65535          17
+//   T  |adc_T/16 - dig_T1|                        0 .. 65535          17  16
+//   T  d^2                                        0 .. 4294836225     33  !
+//   T  d2 = d^2/4096                              0 .. 1048544        21
+//   T  d2*dig_T3                       -34358689792 .. 34357641248    36  !
+//   T  var2 = d2*dig_T3/16384              -2097088 .. 2097024        22
+//   T  t_fine                              -4194224 .. 4194144        23
+//   H  v = t_fine - 76800                   -281600 .. 358400         20
+//   H  adc_H*16384                                0 .. 1073725440     31
+//   H  dig_H4*1048576                   -2147483648 .. 2146435072     32
+//   H  v*dig_H5                          -734003200 .. 733644800      31
+//   H  soma de x (+16384)               -2880063488 .. 3955228672     33  !
+//   H  x = soma/32768                        -87892 .. 120704         18
+//   H  v*dig_H6                           -45875200 .. 45516800       27
+//   H  y1 = v*dig_H6/1024                    -44800 .. 44450          17
+//   H  v*dig_H3                           -71808000 .. 91392000       28
+//   H  y2 = v*dig_H3/2048 + 32768             -2294 .. 77393          18
+//   H  y1*y2                            -3467206400 .. 3440118850     33  !
+//   H  y = y1*y2/1024 + 2097152            -1288791 .. 5456643        24
+//   H  y*dig_H2 + 8192                -178803269632 .. 178797829373   39  !
+//   H  y = (y*dig_H2 + 8192)/16384        -10913285 .. 10912953       25
+//   H  v = x*y                       -1317277152640 .. 1317237078912  42  !
+//   H  q = |v/32768|                              0 .. 65536          18
+//   H  q*q                                        0 .. 4294967296     34  !
+//   H  q*q/128                                    0 .. 33554432       27
+//   H  q*q/128*dig_H1                             0 .. 8556380160     34  !
+//   H  q*q/128*dig_H1/16                          0 .. 534773760      30
+//   P  var1 = t_fine/2 - 64000              -166400 .. 153600         19
+//   P  |var1/4|                                   0 .. 41600          17  16
+//   P  q = (var1/4)^2                             0 .. 1730560000     32
+//   P  q/2048*dig_P6                   -27688960000 .. 27688115000    36  !
+//   P  var1*dig_P5                      -5452428800 .. 5452595200     34  !
+//   P  var2 + var1*dig_P5*2            -38593817600 .. 38593305400    37  !
+//   P  dig_P4*65536                     -2147483648 .. 2147418112     32
+//   P  var2 = var2/4 + dig_P4*65536    -11795938048 .. 11795744462    35  !
+//   P  q/8192*dig_P3                    -6922240000 .. 6922028750     34  !
+//   P  q/8192*dig_P3/8                   -865280000 .. 865253593      31
+//   P  dig_P2*var1                      -5452428800 .. 5452595200     34  !
+//   P  dig_P2*var1/2                    -2726214400 .. 2726297600     33  !
+//   P  soma de var1                     -3591494400 .. 3591551193     33  !
+//   P  var1 = soma/262144                    -13700 .. 13700          15  16
+//   P  32768 + var1                           19068 .. 46468          17  16
+//   P  (32768 + var1)*dig_P1                      0 .. 3045280380     33  !
+//   P  divisor = (...)*dig_P1/32768               0 .. 92934          18
+//   P  1048576 - adc_P - var2/4096         -2879819 .. 3928443        23
+//   P  (...)*3125                       -8999434375 .. 12276384375    35  !
+//   P  p/8 (faixa de operação)                 3750 .. 13750          15  16
+//   P  (p/8)^2/8192                            1716 .. 23078          16  16
+//   P  (p/8)^2/8192*dig_P9               -756219904 .. 756196826      31
+//   P  (...)*dig_P9/4096                    -184624 .. 184618         19
+//   P  (p/4)*dig_P8                      -901120000 .. 901092500      31
+//   P  (p/4)*dig_P8/8192                    -110000 .. 109996         18
+
+// Marca canais para compensar de novo; com BME280_CALIBRACAO também a parte
+// fixa da pressão e o recíproco do divisor (coeficientes trocados)
+void BME280_Invalidate(unsigned char canais) {
+    if(canais & BME280_CALIBRACAO) {
+        bme280_p_valido = 0;
+        bme280_p_div = 0;                                                       // Refaz também o recíproco
+    }
+    bme280_sujos |= canais & (BME280_CANAL_T | BME280_CANAL_H | BME280_CANAL_P);
+}
 
-    BME280_Update();                                                            // Atualiza leituras
+// Compensa a temperatura do adc_T atual (t_fine e centésimos de °C)
+static void BME280_CompensateT(void) {
+    long var1, var2;                                                            // Variáveis auxiliares cálculo
 
-    // Calcula temperatura usando coeficientes de calibrao
-    var1 = ((((adc_T / 8) - ((long)BME280_calib.dig_T1 * 2))) *
-           ((long)BME280_calib.dig_T2)) / 2048;
+    // Calcula temperatura usando coeficientes de calibração
+    var1 = MUL_32x16((adc_T / 8) - ((long)BME280_calib.dig_T1 * 2),
+                     BME280_calib.dig_T2) / 2048;
 
-    var2 = (((((adc_T / 16) - ((long)BME280_calib.dig_T1)) *
-           ((adc_T / 16) - ((long)BME280_calib.dig_T1))) / 4096) *
-           ((long)BME280_calib.dig_T3)) / 16384;
+    var2 = (adc_T / 16) - ((long)BME280_calib.dig_T1);                          // |var2| < 65536: quadrado em 16x16
+    var2 = (long)MUL_Square(var2) / 4096;                                       // Acima de 2^31 vira negativo como no long
+    var2 = MUL_32x16(var2, BME280_calib.dig_T3) / 16384;
 
     t_fine = var1 + var2;                                                       // Temperatura calibrada
-    *temp = (t_fine * 5 + 128) / 256;                                           // Converte para centsimos C
+    bme280_temp = (t_fine * 5 + 128) / 256;                                     // Converte para centésimos °C
+
+    bme280_sujos &= ~BME280_CANAL_T;
+}
+
+// Lê temperatura em centésimos de grau Celsius
+unsigned short ReadTemperature(long *temp) {
+    if(bme280_sujos & BME280_CANAL_T)
+        BME280_CompensateT();
+
+    *temp = bme280_temp;                                                        // Atualiza ponteiro
 
     return 1;                                                                   // Retorna sucesso
 }
 
-// L umidade relativa em passos de 1024 (47445 = 46.333%)
-unsigned short ReadHumidity(unsigned long *humi) {
-    long v_x1_u32r;                                                             // Varivel auxiliar clculo
-    unsigned long H;                                                            // Umidade calculada
+// Compensa a umidade do adc_H atual (depende de t_fine)
+static void BME280_CompensateH(void) {
+    long v_x1_u32r;                                                             // Variável auxiliar cálculo
+    long x, y;                                                                  // Fatores do produto principal
 
-    // Clculo complexo usando coeficientes de calibrao
+    if(bme280_sujos & BME280_CANAL_T)                                           // t_fine precisa estar em dia
+        BME280_CompensateT();
+
+    // Cálculo complexo usando coeficientes de calibração
     v_x1_u32r = (t_fine - ((long)76800));
-    v_x1_u32r = (((((adc_H * 16384) - (((long)BME280_calib.dig_H4) * 1048576) -
-                (((long)BME280_calib.dig_H5) * v_x1_u32r)) + ((long)16384)) / 32768) *
-                (((((((v_x1_u32r * ((long)BME280_calib.dig_H6)) / 1024) *
-                (((v_x1_u32r * ((long)BME280_calib.dig_H3)) / 2048) + ((long)32768))) / 1024) +
-                ((long)2097152)) * ((long)BME280_calib.dig_H2) + 8192) / 16384));
+    x = (((adc_H * 16384) - (((long)BME280_calib.dig_H4) * 1048576) -
+        MUL_32x16(v_x1_u32r, BME280_calib.dig_H5)) + ((long)16384)) / 32768;
+    y = (((MUL_32x16(v_x1_u32r, BME280_calib.dig_H6) / 1024) *
+        ((MUL_32xU16(v_x1_u32r, BME280_calib.dig_H3) / 2048) + ((long)32768))) / 1024) +
+        ((long)2097152);
+    y = (MUL_32x16(y, BME280_calib.dig_H2) + 8192) / 16384;
+    v_x1_u32r = x * y;                                                          // Dois fatores de 17 bits: 32x32
 
-    v_x1_u32r = (v_x1_u32r - (((((v_x1_u32r / 32768) * (v_x1_u32r / 32768)) / 128) *
-                ((long)BME280_calib.dig_H1)) / 16));
+    v_x1_u32r = (v_x1_u32r - (MUL_32xU16((long)MUL_Square(v_x1_u32r / 32768) / 128,
+                BME280_calib.dig_H1) / 16));
 
     // Limita resultado entre 0 e 419430400
     v_x1_u32r = (v_x1_u32r < 0 ? 0 : v_x1_u32r);
     v_x1_u32r = (v_x1_u32r > 419430400 ? 419430400 : v_x1_u32r);
 
-    H = (unsigned long)(v_x1_u32r / 4096);                                      // Converte para formato final
-    *humi = H;                                                                  // Atualiza ponteiro
+    bme280_umid = (unsigned long)(v_x1_u32r / 4096);                            // Converte para formato final
+
+    bme280_sujos &= ~BME280_CANAL_H;
+}
+
+// Lê umidade relativa em passos de 1024 (47445 = 46.333%)
+unsigned short ReadHumidity(unsigned long *humi) {
+    if(bme280_sujos & BME280_CANAL_H)
+        BME280_CompensateH();
+
+    *humi = bme280_umid;                                                        // Atualiza ponteiro
 
     return 1;                                                                   // Retorna sucesso
 }
 
-// L presso em Pascal (96386 = 963.86 hPa)
-unsigned short ReadPressure(unsigned long *pres) {
-    long var1, var2;                                                            // Variveis auxiliares
-    unsigned long p;                                                            // Presso calculada
+// floor(2^32 / d) para d >= 2 (uma divisão, só quando o divisor muda)
+static unsigned long BME280_Reciprocal(unsigned long d) {
+    unsigned long m;
+
+    m = 0xFFFFFFFF / d;
+    if(0xFFFFFFFF - m * d == d - 1)                                             // d divide 2^32
+        m++;
+
+    return m;
+}
+
+// n / bme280_p_div pelo recíproco guardado, com uma correção
+static unsigned long BME280_Divide(unsigned long n) {
+#if USE_MUL_8X8
+    unsigned long q, r;
+
+    if(bme280_p_div == 1)                                                       // 2^32 não cabe em m
+        return n;
+
+    q = MUL_High32(n, bme280_p_inv);                                            // Quociente ou quociente - 1
+    if(bme280_p_div < 65536)
+        r = n - (unsigned long)MUL_32xU16(q, (unsigned int)bme280_p_div);
+    else
+        r = n - q * bme280_p_div;
+    if(r >= bme280_p_div)
+        q++;
+
+    return q;
+#else
+    return n / bme280_p_div;                                                    // Referência para a medida
+#endif
+}
+
+// Calcula var2 e o divisor da pressão para o t_fine atual
+static void BME280_PressureBase(void) {
+    long var1, var2, q;                                                         // Variáveis auxiliares
 
-    // Calcula presso usando coeficientes de calibrao
     var1 = (((long)t_fine) / 2) - (long)64000;
-    var2 = (((var1/4) * (var1/4)) / 2048) * ((long)BME280_calib.dig_P6);
-    var2 = var2 + ((var1 * ((long)BME280_calib.dig_P5)) * 2);
+    q = MUL_Square(var1/4);                                                     // Quadrado usado duas vezes
+    var2 = MUL_32x16(q / 2048, BME280_calib.dig_P6);
+    var2 = var2 + (MUL_32x16(var1, BME280_calib.dig_P5) * 2);
     var2 = (var2/4) + (((long)BME280_calib.dig_P4) * 65536);
-    var1 = ((((long)BME280_calib.dig_P3 * (((var1/4) * (var1/4)) / 8192)) / 8) +
-           ((((long)BME280_calib.dig_P2) * var1)/2)) / 262144;
-    var1 =((((32768 + var1)) * ((long)BME280_calib.dig_P1)) / 32768);
+    var1 = ((MUL_32x16(q / 8192, BME280_calib.dig_P3) / 8) +
+           (MUL_32x16(var1, BME280_calib.dig_P2) / 2)) / 262144;
+    if(var1 >= -32768 && var1 <= 32767)                                         // 32768 + var1 cabe em 16 bits
+        var1 = (long)MUL_16x16U((unsigned int)(32768 + var1), BME280_calib.dig_P1) / 32768;
+    else
+        var1 = MUL_32xU16(32768 + var1, BME280_calib.dig_P1) / 32768;
 
-    if (var1 == 0)                                                              // Evita diviso por zero
-        return 0;
+    bme280_p_var2 = var2 / 4096;
+    if((unsigned long)var1 != bme280_p_div) {
+        bme280_p_div = var1;
+        if(bme280_p_div > 1)
+            bme280_p_inv = BME280_Reciprocal(bme280_p_div);
+    }
+
+    bme280_p_tfine = t_fine;
+    bme280_p_valido = 1;
+}
 
-    p = (((unsigned long)(((long)1048576) - adc_P) - (var2 / 4096))) * 3125;
+// Compensa a pressão do adc_P atual (depende de t_fine)
+static void BME280_CompensateP(void) {
+    long var1, var2;                                                            // Variáveis auxiliares
+    unsigned long p;                                                            // Pressão calculada
+
+    if(bme280_sujos & BME280_CANAL_T)                                           // t_fine precisa estar em dia
+        BME280_CompensateT();
+    bme280_sujos &= ~BME280_CANAL_P;
+
+    // Parte que só depende de t_fine e da calibração
+    if(!bme280_p_valido || t_fine != bme280_p_tfine)
+        BME280_PressureBase();
+
+    bme280_pres_ok = bme280_p_div != 0;
+    if (!bme280_pres_ok)                                                        // Evita divisão por zero
+        return;
+
+    p = (((unsigned long)(((long)1048576) - adc_P) - bme280_p_var2)) * 3125;
 
     if (p < 0x80000000)
-        p = (p * 2) / ((unsigned long)var1);
+        p = BME280_Divide(p * 2);
     else
-        p = (p / (unsigned long)var1) * 2;
+        p = BME280_Divide(p) * 2;
 
-    var1 = (((long)BME280_calib.dig_P9) * ((long)(((p/8) * (p/8)) / 8192))) / 4096;
-    var2 = (((long)(p/4)) * ((long)BME280_calib.dig_P8)) / 8192;
+    var1 = MUL_32x16((long)(MUL_Square(p/8) / 8192), BME280_calib.dig_P9) / 4096;
+    var2 = MUL_32x16((long)(p/4), BME280_calib.dig_P8) / 8192;
 
-    p = (unsigned long)((long)p + ((var1 + var2 + (long)BME280_calib.dig_P7) / 16));
+    bme280_pres = (unsigned long)((long)p + ((var1 + var2 + (long)BME280_calib.dig_P7) / 16));
+}
+
+// Lê pressão em Pascal (96386 = 963.86 hPa)
+unsigned short ReadPressure(unsigned long *pres) {
+    if(bme280_sujos & BME280_CANAL_P)
+        BME280_CompensateP();
+
+    if(!bme280_pres_ok)                                                         // Calibração dá divisor zero
+        return 0;
 
-    *pres = p;                                                                  // Atualiza ponteiro
+    *pres = bme280_pres;                                                        // Atualiza ponteiro
 
     return 1;                                                                   // Retorna sucesso
 }
\ No newline at end of file
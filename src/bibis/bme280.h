@@ -2,40 +2,49 @@
  * Biblioteca: Driver BME280 (bme280.h)
  * Autor: Elison Nogueira
  * Data: 16/11/2024
- * Verso: 1.0
+ * Versão: 1.0
  * Plataforma: PIC18F25K50 (Microchip)
  * Compilador: mikroC Pro for PIC v7.6.0
  *
- * Descrio:
+ * Descrição:
  * Driver para sensor BME280 da Bosch que realiza leituras de temperatura,
- * umidade e presso atmosfrica via interface I2C. O driver suporta:
- * - Modo normal, forado e sleep
- * - Configurao de oversampling para temp/presso/umidade
- * - Filtro digital configurvel
- * - Tempo de standby ajustvel
+ * umidade e pressão atmosférica via interface I2C. O driver suporta:
+ * - Modo normal, forçado e sleep
+ * - Configuração de oversampling para temp/pressão/umidade
+ * - Filtro digital configurável
+ * - Tempo de standby ajustável
+ * - Compensação sob demanda: BME280_Update lê os brutos; cada Read* compensa
+ *   o seu canal só se o bruto mudou desde a última compensação (conferida
+ *   no host contra a compensação completa por bme280_teste.c)
  *
- * Dependncias:
+ * Dependências:
  * - Biblioteca I2C do mikroC PRO for PIC
  *
- * Limitaes:
- * - Apenas comunicao I2C (no suporta SPI)
- * - Preciso de temperatura: 0.01C
- * - Preciso de umidade: 0.008%
- * - Preciso de presso: 0.18Pa
+ * Limitações:
+ * - Apenas comunicação I2C (não suporta SPI)
+ * - Precisão de temperatura: 0.01°C
+ * - Precisão de umidade: 0.008%
+ * - Precisão de pressão: 0.18Pa
  *****************************************************************************/
 
-// Endereos I2C possveis do BME280
+// Endereços I2C possíveis do BME280
 #define BME280_ADDR_LOW  0xEC                                                   // SDO/CSB conectado ao GND
 #define BME280_ADDR_HIGH 0xEE                                                   // SDO/CSB conectado ao VDD
 
 #define BME280_CHIP_ID        0x60                                              // ID do chip BME280
 
-// Registradores de calibrao de temperatura
+// Canais da compensação sob demanda
+#define BME280_CANAL_T        0x01                                              // Temperatura (e t_fine)
+#define BME280_CANAL_H        0x02                                              // Umidade
+#define BME280_CANAL_P        0x04                                              // Pressão
+#define BME280_CALIBRACAO     0x08                                              // Calibração trocada (parte fixa da pressão)
+
+// Registradores de calibração de temperatura
 #define BME280_REG_DIG_T1     0x88                                              // Registrador T1
 #define BME280_REG_DIG_T2     0x8A                                              // Registrador T2
 #define BME280_REG_DIG_T3     0x8C                                              // Registrador T3
 
-// Registradores de calibrao de presso
+// Registradores de calibração de pressão
 #define BME280_REG_DIG_P1     0x8E                                              // Registrador P1
 #define BME280_REG_DIG_P2     0x90                                              // Registrador P2
 #define BME280_REG_DIG_P3     0x92                                              // Registrador P3
@@ -46,7 +55,7 @@
 #define BME280_REG_DIG_P8     0x9C                                              // Registrador P8
 #define BME280_REG_DIG_P9     0x9E                                              // Registrador P9
 
-// Registradores de calibrao de umidade
+// Registradores de calibração de umidade
 #define BME280_REG_DIG_H1     0xA1                                              // Registrador H1
 #define BME280_REG_DIG_H2     0xE1                                              // Registrador H2
 #define BME280_REG_DIG_H3     0xE3                                              // Registrador H3
@@ -60,23 +69,23 @@
 #define BME280_REG_CTRLHUM    0xF2                                              // Controle de umidade
 #define BME280_REG_STATUS     0xF3                                              // Status
 #define BME280_REG_CONTROL    0xF4                                              // Controle principal
-#define BME280_REG_CONFIG     0xF5                                              // Configurao
-#define BME280_REG_PRESS_MSB  0xF7                                              // MSB da presso
+#define BME280_REG_CONFIG     0xF5                                              // Configuração
+#define BME280_REG_PRESS_MSB  0xF7                                              // MSB da pressão
 
 
-// Variveis externas para armazenamento das leituras ADC
+// Variáveis externas para armazenamento das leituras ADC
 extern long adc_T, adc_P, adc_H, t_fine;
-// Varivel externas para armazenamento do endereamento do BME280
+// Variável externas para armazenamento do endereçamento do BME280
 extern unsigned char ADD_BME280;
 
-// Enumerao para modos de operao do BME280
+// Enumeração para modos de operação do BME280
 typedef enum {
     MODE_SLEEP  = 0x00,                                                         // Modo sleep (baixo consumo)
-    MODE_FORCED = 0x01,                                                         // Modo forado (uma leitura)
-    MODE_NORMAL = 0x03                                                          // Modo normal (leituras contnuas)
+    MODE_FORCED = 0x01,                                                         // Modo forçado (uma leitura)
+    MODE_NORMAL = 0x03                                                          // Modo normal (leituras contínuas)
 } bme280_mode;
 
-// Enumerao para configurao de oversampling
+// Enumeração para configuração de oversampling
 typedef enum {
     SAMPLING_SKIPPED = 0x00,                                                    // Desabilita leitura
     SAMPLING_X1      = 0x01,                                                    // Oversampling x1
@@ -86,7 +95,7 @@ typedef enum {
     SAMPLING_X16     = 0x05                                                     // Oversampling x16
 } bme280_sampling;
 
-// Enumerao para configurao do filtro digital
+// Enumeração para configuração do filtro digital
 typedef enum {
     FILTER_OFF = 0x00,                                                          // Filtro desligado
     FILTER_2   = 0x01,                                                          // Coeficiente 2
@@ -95,7 +104,7 @@ typedef enum {
     FILTER_16  = 0x04                                                           // Coeficiente 16
 } bme280_filter;
 
-// Enumerao para tempo de standby
+// Enumeração para tempo de standby
 typedef enum {
     STANDBY_0_5   =  0x00,                                                      // 0.5ms
     STANDBY_62_5  =  0x01,                                                      // 62.5ms
@@ -107,34 +116,49 @@ typedef enum {
     STANDBY_20    =  0x07                                                       // 20ms
 } standby_time;
 
-// Estrutura para armazenar dados de calibrao
+// Estrutura para armazenar dados de calibração
 typedef struct {
-    unsigned int dig_T1;                                                        // Calibrao T1
-    int  dig_T2;                                                                // Calibrao T2
-    int  dig_T3;                                                                // Calibrao T3
-    unsigned int dig_P1;                                                        // Calibrao P1
-    int  dig_P2;                                                                // Calibrao P2
-    int  dig_P3;                                                                // Calibrao P3
-    int  dig_P4;                                                                // Calibrao P4
-    int  dig_P5;                                                                // Calibrao P5
-    int  dig_P6;                                                                // Calibrao P6
-    int  dig_P7;                                                                // Calibrao P7
-    int  dig_P8;                                                                // Calibrao P8
-    int  dig_P9;                                                                // Calibrao P9
-    unsigned short  dig_H1;                                                     // Calibrao H1
-    int  dig_H2;                                                                // Calibrao H2
-    unsigned short  dig_H3;                                                     // Calibrao H3
-    int  dig_H4;                                                                // Calibrao H4
-    int  dig_H5;                                                                // Calibrao H5
-    short   dig_H6;                                                             // Calibrao H6
+    unsigned int dig_T1;                                                        // Calibração T1
+    int  dig_T2;                                                                // Calibração T2
+    int  dig_T3;                                                                // Calibração T3
+    unsigned int dig_P1;                                                        // Calibração P1
+    int  dig_P2;                                                                // Calibração P2
+    int  dig_P3;                                                                // Calibração P3
+    int  dig_P4;                                                                // Calibração P4
+    int  dig_P5;                                                                // Calibração P5
+    int  dig_P6;                                                                // Calibração P6
+    int  dig_P7;                                                                // Calibração P7
+    int  dig_P8;                                                                // Calibração P8
+    int  dig_P9;                                                                // Calibração P9
+    unsigned short  dig_H1;                                                     // Calibração H1
+    int  dig_H2;                                                                // Calibração H2
+    unsigned short  dig_H3;                                                     // Calibração H3
+    int  dig_H4;                                                                // Calibração H4
+    int  dig_H5;                                                                // Calibração H5
+    short   dig_H6;                                                             // Calibração H6
 } calib_bme280;
 
-// Prottipos das funes
+// Estrutura com a última configuração gravada no sensor
+typedef struct {
+    bme280_mode mode;                                                           // Modo de operação
+    bme280_sampling T_sampling;                                                 // Oversampling temperatura
+    bme280_sampling H_sampling;                                                 // Oversampling umidade
+    bme280_sampling P_sampling;                                                 // Oversampling pressão
+    bme280_filter filter;                                                       // Filtro IIR
+    standby_time standby;                                                       // Tempo de standby
+} config_bme280;
+
+// Variável externa com a configuração atual do sensor
+extern config_bme280 BME280_cfg;
+// Variável externa com os coeficientes de calibração em uso
+extern calib_bme280 BME280_calib;
+
+// Protótipos das funções
 void I2C_Write8(unsigned short reg_addr, unsigned short _data);                 // Escreve 1 byte via I2C
-unsigned short I2C_Read8(unsigned short reg_addr);                              // L 1 byte via I2C
-unsigned int I2C_Read16(unsigned short reg_addr);                               // L 2 bytes via I2C
-unsigned char BME280_TestConnection(void);                                      // Testa a conexo com sensor na inicializao
-void BME280_Configure(bme280_mode mode, bme280_sampling T_sampling,             // Configura parmetros do sensor
+unsigned short I2C_Read8(unsigned short reg_addr);                              // Lê 1 byte via I2C
+unsigned int I2C_Read16(unsigned short reg_addr);                               // Lê 2 bytes via I2C
+unsigned char BME280_TestConnection(void);                                      // Testa a conexão com sensor na inicialização
+void BME280_Configure(bme280_mode mode, bme280_sampling T_sampling,             // Configura parâmetros do sensor
                      bme280_sampling H_sampling, bme280_sampling P_sampling,
                      bme280_filter filter, standby_time standby);
 unsigned short BME280_begin(bme280_mode mode,                                   // Inicializa o sensor
@@ -143,8 +167,17 @@ unsigned short BME280_begin(bme280_mode mode,
                           bme280_sampling P_sampling,
                           bme280_filter filter,
                           standby_time standby);
-unsigned short BME280_ForcedMeasurement();                                      // Realiza medio forada
-void BME280_Update();                                                           // Atualiza leituras do ADC
-unsigned short ReadTemperature(long *temp);                                     // L temperatura
-unsigned short ReadHumidity(unsigned long *humi);                               // L umidade
-unsigned short ReadPressure(unsigned long *pres);                               // L presso
\ No newline at end of file
+unsigned short BME280_ForcedMeasurement();                                      // Realiza medição forçada
+void BME280_Update();                                                           // Lê os brutos do ADC e marca os canais que mudaram
+unsigned long BME280_MeasTime(unsigned char osrs_t, unsigned char osrs_h,       // Tempo de conversão máximo (µs)
+                              unsigned char osrs_p);
+unsigned long BME280_NormalPeriod(void);                                        // Período do modo normal com a configuração atual (µs)
+unsigned char BME280_Measuring(void);                                           // 1 = conversão em andamento
+void BME280_MarkConversion(void);                                               // Informa que um ciclo do modo normal já passou
+unsigned char BME280_Fresh(void);                                               // 1 = a última leitura trouxe conversão nova
+unsigned int BME280_NewCount(void);                                             // Leituras novas (módulo 65536)
+unsigned int BME280_RepeatCount(void);                                          // Leituras repetidas (módulo 65536)
+void BME280_Invalidate(unsigned char canais);                                   // Força a compensação dos canais (BME280_CANAL_*, BME280_CALIBRACAO)
+unsigned short ReadTemperature(long *temp);                                     // Temperatura dos últimos brutos (compensa se mudou)
+unsigned short ReadHumidity(unsigned long *humi);                               // Umidade dos últimos brutos (compensa se mudou)
+unsigned short ReadPressure(unsigned long *pres);                               // Pressão dos últimos brutos (compensa se mudou)
\ No newline at end of file
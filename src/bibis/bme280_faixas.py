@@ -0,0 +1,189 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+###############################################################################
+# Ferramenta: Análise de faixas da compensação do BME280 (bme280_faixas.py)
+# Autor: Elison Nogueira
+# Data: 18/10/2026
+# Versão: 1.0
+# Plataforma: PC (Python 3), não faz parte do firmware
+#
+# Descrição:
+# Propaga intervalos por cada passo da compensação de bme280.c, com os
+# mesmos nomes e operações (divisão inteira truncada, como em C), e imprime
+# a faixa e os bits de cada intermediário. Cada produto aparece antes da
+# divisão que o segue, pois é nele que o long pode estourar. A saída é colada
+# no comentário de faixas em bme280.c; rode de novo se a compensação mudar.
+#
+# Entradas (datasheet BME280, tabelas 16 e 1):
+# - Brutos: adc_T e adc_P com 20 bits, adc_H com 16 bits
+# - Coeficientes: a faixa inteira do tipo de cada registrador (dig_H4 e
+#   dig_H5 têm 12 bits com sinal)
+# - t_fine das etapas de umidade e pressão: faixa de operação, -40..85°C
+#   (t_fine = T * 5120); a etapa de temperatura com coeficientes quaisquer
+#   não limita t_fine
+# - Final da pressão: faixa de operação, 300..1100 hPa, porque a divisão por
+#   var1 não tem limite quando var1 se aproxima de zero
+#
+# Colunas: faixa matemática (sem dar a volta), bits com sinal e a marca:
+#   16  cabe em int (ou o módulo cabe em unsigned int)
+#   !   passa de 32 bits: o long dá a volta; a fórmula da Bosch conta com os
+#       coeficientes reais do sensor para não chegar lá
+#
+# Uso: python3 bme280_faixas.py
+###############################################################################
+
+T_MIN, T_MAX = -40, 85                                                          # Faixa de operação (°C)
+P_MIN, P_MAX = 30000, 110000                                                    # Faixa de operação (Pa)
+
+S16 = (-32768, 32767)
+U16 = (0, 65535)
+U8 = (0, 255)
+S8 = (-128, 127)
+S12 = (-2048, 2047)
+
+CAL = {
+    'dig_T1': U16, 'dig_T2': S16, 'dig_T3': S16,
+    'dig_P1': U16, 'dig_P2': S16, 'dig_P3': S16, 'dig_P4': S16, 'dig_P5': S16,
+    'dig_P6': S16, 'dig_P7': S16, 'dig_P8': S16, 'dig_P9': S16,
+    'dig_H1': U8, 'dig_H2': S16, 'dig_H3': U8, 'dig_H4': S12, 'dig_H5': S12,
+    'dig_H6': S8,
+}
+
+
+# Divisão inteira de C (trunca em direção a zero)
+def cdiv(a, b):
+    q = abs(a) // abs(b)
+    return q if (a >= 0) == (b > 0) else -q
+
+
+# Operações sobre intervalos (lo, hi)
+def add(a, b):
+    return (a[0] + b[0], a[1] + b[1])
+
+
+def sub(a, b):
+    return (a[0] - b[1], a[1] - b[0])
+
+
+def mul(a, b):
+    c = [a[0] * b[0], a[0] * b[1], a[1] * b[0], a[1] * b[1]]
+    return (min(c), max(c))
+
+
+def sq(a):
+    m = max(abs(a[0]), abs(a[1]))
+    return (0 if a[0] <= 0 <= a[1] else min(a[0] * a[0], a[1] * a[1]), m * m)
+
+
+def div(a, k):
+    return (cdiv(a[0], k), cdiv(a[1], k))
+
+
+def mag(a):
+    return (0 if a[0] <= 0 <= a[1] else min(abs(a[0]), abs(a[1])), max(abs(a[0]), abs(a[1])))
+
+
+def k(v):
+    return (v, v)
+
+
+def bits(a):
+    n = 1
+    while not (-(1 << (n - 1)) <= a[0] and a[1] < (1 << (n - 1))):
+        n += 1
+    return n
+
+
+linhas = []
+
+
+def mostra(nome, a):
+    marca = ''
+    if a[0] < -(1 << 31) or a[1] >= (1 << 31):
+        marca = '!'
+    elif bits(a) <= 16 or (a[0] >= 0 and a[1] <= 65535):
+        marca = '16'
+    linhas.append((nome, a, bits(a), marca))
+    return a
+
+
+def temperatura():
+    c = CAL
+    adc_T = (0, (1 << 20) - 1)
+    a = mostra('T  adc_T/8 - 2*dig_T1', sub(div(adc_T, 8), mul(k(2), c['dig_T1'])))
+    a = mostra('T  a*dig_T2', mul(a, c['dig_T2']))
+    var1 = mostra('T  var1 = a*dig_T2/2048', div(a, 2048))
+    x = mostra('T  adc_T/16 - dig_T1', sub(div(adc_T, 16), c['dig_T1']))
+    d = mostra('T  |adc_T/16 - dig_T1|', mag(x))
+    d2 = mostra('T  d^2', sq(d))
+    d2 = mostra('T  d2 = d^2/4096', div(d2, 4096))
+    var2 = mostra('T  d2*dig_T3', mul(d2, c['dig_T3']))
+    var2 = mostra('T  var2 = d2*dig_T3/16384', div(var2, 16384))
+    mostra('T  t_fine', add(var1, var2))
+
+
+def umidade(t_fine):
+    c = CAL
+    adc_H = (0, (1 << 16) - 1)
+    v = mostra('H  v = t_fine - 76800', sub(t_fine, k(76800)))
+    a = mostra('H  adc_H*16384', mul(adc_H, k(16384)))
+    b = mostra('H  dig_H4*1048576', mul(c['dig_H4'], k(1048576)))
+    e = mostra('H  v*dig_H5', mul(v, c['dig_H5']))
+    x = mostra('H  soma de x (+16384)', add(sub(sub(a, b), e), k(16384)))
+    x = mostra('H  x = soma/32768', div(x, 32768))
+    y1 = mostra('H  v*dig_H6', mul(v, c['dig_H6']))
+    y1 = mostra('H  y1 = v*dig_H6/1024', div(y1, 1024))
+    y2 = mostra('H  v*dig_H3', mul(v, c['dig_H3']))
+    y2 = mostra('H  y2 = v*dig_H3/2048 + 32768', add(div(y2, 2048), k(32768)))
+    y = mostra('H  y1*y2', mul(y1, y2))
+    y = mostra('H  y = y1*y2/1024 + 2097152', add(div(y, 1024), k(2097152)))
+    y = mostra('H  y*dig_H2 + 8192', add(mul(y, c['dig_H2']), k(8192)))
+    y = mostra('H  y = (y*dig_H2 + 8192)/16384', div(y, 16384))
+    v = mostra('H  v = x*y', mul(x, y))
+    v = (max(v[0], -(1 << 31)), min(v[1], (1 << 31) - 1))                      # O long só guarda 32 bits
+    q = mostra('H  q = |v/32768|', mag(div(v, 32768)))
+    q = mostra('H  q*q', sq(q))
+    q = mostra('H  q*q/128', div(q, 128))
+    q = mostra('H  q*q/128*dig_H1', mul(q, c['dig_H1']))
+    mostra('H  q*q/128*dig_H1/16', div(q, 16))
+
+
+def pressao(t_fine):
+    c = CAL
+    var1 = mostra('P  var1 = t_fine/2 - 64000', sub(div(t_fine, 2), k(64000)))
+    r = mostra('P  |var1/4|', mag(div(var1, 4)))
+    q = mostra('P  q = (var1/4)^2', sq(r))
+    var2 = mostra('P  q/2048*dig_P6', mul(div(q, 2048), c['dig_P6']))
+    e = mostra('P  var1*dig_P5', mul(var1, c['dig_P5']))
+    var2 = mostra('P  var2 + var1*dig_P5*2', add(var2, mul(e, k(2))))
+    e = mostra('P  dig_P4*65536', mul(c['dig_P4'], k(65536)))
+    var2 = mostra('P  var2 = var2/4 + dig_P4*65536', add(div(var2, 4), e))
+    a = mostra('P  q/8192*dig_P3', mul(div(q, 8192), c['dig_P3']))
+    a = mostra('P  q/8192*dig_P3/8', div(a, 8))
+    b = mostra('P  dig_P2*var1', mul(c['dig_P2'], var1))
+    b = mostra('P  dig_P2*var1/2', div(b, 2))
+    var1 = mostra('P  soma de var1', add(a, b))
+    var1 = mostra('P  var1 = soma/262144', div(var1, 262144))
+    a = mostra('P  32768 + var1', add(k(32768), var1))
+    a = mostra('P  (32768 + var1)*dig_P1', mul(a, c['dig_P1']))
+    mostra('P  divisor = (...)*dig_P1/32768', div(a, 32768))
+    adc_P = (0, (1 << 20) - 1)
+    n = mostra('P  1048576 - adc_P - var2/4096', sub(sub(k(1048576), adc_P), div(var2, 4096)))
+    mostra('P  (...)*3125', mul(n, k(3125)))
+    p = (P_MIN, P_MAX)
+    p8 = mostra('P  p/8 (faixa de operação)', div(p, 8))
+    a = mostra('P  (p/8)^2/8192', div(sq(p8), 8192))
+    a = mostra('P  (p/8)^2/8192*dig_P9', mul(a, c['dig_P9']))
+    mostra('P  (...)*dig_P9/4096', div(a, 4096))
+    a = mostra('P  (p/4)*dig_P8', mul(div(p, 4), c['dig_P8']))
+    mostra('P  (p/4)*dig_P8/8192', div(a, 8192))
+
+
+t_fine = (T_MIN * 5120, T_MAX * 5120)
+temperatura()
+umidade(t_fine)
+pressao(t_fine)
+
+print('//   %-32s %14s .. %-14s %s' % ('Passo', 'Mínimo', 'Máximo', 'Bits'))
+for nome, a, n, marca in linhas:
+    print(('//   %-32s %14d .. %-14d %2d  %s' % (nome, a[0], a[1], n, marca)).rstrip())
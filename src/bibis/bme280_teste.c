@@ -0,0 +1,436 @@
+/******************************************************************************
+ * Teste no host: Compensação do BME280 e multiplicações (bme280_teste.c)
+ * Autor: Elison Nogueira
+ * Data: 18/10/2026
+ * Versão: 1.0
+ * Plataforma: PC (gcc)
+ *
+ * Descrição:
+ * Confere no PC o mult.c e o bme280.c do firmware contra referências de
+ * 64 bits e contra a compensação original da Bosch (a de bme280.c antes das
+ * rotinas 8x8, do recíproco e da compensação sob demanda):
+ *
+ *   Teste         Referência                    Entradas
+ *   MUL_*         Produto de 64 bits            Cantos e TST_SORTEIOS pares
+ *   MUL_High32    (a * b) >> 32 em 64 bits      Cantos e TST_SORTEIOS pares
+ *   Divisão       n / d do compilador           Cantos e TST_SORTEIOS pares,
+ *                                               recíproco como ReadPressure
+ *   Compensação   Fórmula original              Todo adc_T; todo adc_H e todo
+ *                                               adc_P em TST_TFINE t_fine
+ *   Sob demanda   Fórmula original nos brutos   TST_PASSOS leituras I2C com
+ *                 atuais                        canais mudando ou repetidos e
+ *                                               leituras em ordem sorteada
+ *
+ * Calibrações: exemplo do datasheet, os dois extremos do tipo (como em
+ * wcet.c) e TST_CALIBRACOES sorteadas. Sorteios com semente fixa: o
+ * resultado é reprodutível.
+ *
+ * Não compila sozinho: teste_host.py copia os fontes com os tipos do
+ * mikroC e compila este arquivo contra eles nos dois perfis de USE_MUL_8X8
+ * (veja lá).
+ *
+ * Uso: python3 teste_host.py bme280
+ *****************************************************************************/
+
+#include <stdio.h>
+#include <stdint.h>
+
+#define TST_SORTEIOS      20000000UL                                            // Pares sorteados por rotina
+#define TST_CALIBRACOES   6                                                     // Calibrações sorteadas
+#define TST_TFINE         8                                                     // t_fine por calibração (umidade e pressão)
+#define TST_PASSOS        2000000UL                                             // Leituras do teste sob demanda
+#define TST_MOSTRA        5                                                     // Diferenças impressas por teste
+
+// Multiplicador 8x8 do PIC18: PRODH:PRODL = WREG * PRODL
+uint8_t PRODL, PRODH, WREG;
+
+void TST_Mulwf(void) {                                                          // Sem static: com USE_MUL_8X8 = 0 ninguém chama
+    uint16_t p = (uint16_t)WREG * PRODL;
+
+    PRODL = (uint8_t)p;
+    PRODH = (uint8_t)(p >> 8);
+}
+
+#define Lo(x)             ((uint8_t)(x))
+#define Hi(x)             ((uint8_t)((x) >> 8))
+
+// Registradores do sensor servidos pelo I2C simulado
+uint8_t tst_reg[256];
+uint8_t tst_ponteiro, tst_fase;
+
+void I2C_Start(void)   { tst_fase = 0; }
+void I2C_Restart(void) { tst_fase = 3; }
+void I2C_Stop(void)    { }
+void delay_ms(unsigned ms) { }
+
+void I2C_Write(uint8_t d) {
+    if(tst_fase == 0 || tst_fase == 3)                                          // Endereço do sensor
+        tst_fase++;
+    else if(tst_fase == 1) {                                                    // Registrador
+        tst_ponteiro = d;
+        tst_fase = 2;
+    } else if(tst_fase == 2)                                                    // Dado
+        tst_reg[tst_ponteiro++] = d;
+}
+
+uint8_t I2C_Read(uint8_t ack) {
+    return tst_reg[tst_ponteiro++];
+}
+
+// I2C1 de hardware de BME280_TestConnection (não testada)
+uint8_t I2C1_Start(void) { return 1; }
+uint8_t I2C1_Wr(uint8_t d) { return 1; }
+void I2C1_Stop(void) { }
+
+#include "mult_host.c"
+#include "bme280_host.c"
+
+uint32_t tst_semente = 1;
+unsigned int tst_erros;
+
+// Sorteio reprodutível (xorshift de 32 bits)
+static uint32_t TST_Random(void) {
+    tst_semente ^= tst_semente << 13;
+    tst_semente ^= tst_semente >> 17;
+    tst_semente ^= tst_semente << 5;
+    return tst_semente;
+}
+
+// Conta e imprime as primeiras diferenças de um teste
+static unsigned long tst_difs;
+
+static void TST_Dif(const char *teste, long long a, long long b, long long obtido, long long esperado) {
+    if(tst_difs++ < TST_MOSTRA)
+        printf("  %s(%lld, %lld) = %lld, esperado %lld\n", teste, a, b, obtido, esperado);
+}
+
+static void TST_Fim(const char *teste, unsigned long long casos) {
+    printf("%-14s %12llu casos  %s\n", teste, casos, tst_difs ? "FALHOU" : "ok");
+    if(tst_difs)
+        tst_erros++;
+    tst_difs = 0;
+}
+
+// Compensação original (Bosch), em 32 bits que dão a volta como no mikroC
+static int32_t TST_Temperature(int32_t adc, int32_t *tf) {
+    int32_t var1, var2;
+
+    var1 = ((((adc / 8) - ((int32_t)BME280_calib.dig_T1 * 2))) *
+           ((int32_t)BME280_calib.dig_T2)) / 2048;
+    var2 = (((((adc / 16) - ((int32_t)BME280_calib.dig_T1)) *
+           ((adc / 16) - ((int32_t)BME280_calib.dig_T1))) / 4096) *
+           ((int32_t)BME280_calib.dig_T3)) / 16384;
+
+    *tf = var1 + var2;
+    return (*tf * 5 + 128) / 256;
+}
+
+static uint32_t TST_Humidity(int32_t adc, int32_t tf) {
+    int32_t v;
+
+    v = (tf - ((int32_t)76800));
+    v = (((((adc * 16384) - (((int32_t)BME280_calib.dig_H4) * 1048576) -
+        (((int32_t)BME280_calib.dig_H5) * v)) + ((int32_t)16384)) / 32768) *
+        (((((((v * ((int32_t)BME280_calib.dig_H6)) / 1024) *
+        (((v * ((int32_t)BME280_calib.dig_H3)) / 2048) + ((int32_t)32768))) / 1024) +
+        ((int32_t)2097152)) * ((int32_t)BME280_calib.dig_H2) + 8192) / 16384));
+    v = (v - (((((v / 32768) * (v / 32768)) / 128) * ((int32_t)BME280_calib.dig_H1)) / 16));
+    v = (v < 0 ? 0 : v);
+    v = (v > 419430400 ? 419430400 : v);
+
+    return (uint32_t)(v / 4096);
+}
+
+static uint8_t TST_Pressure(int32_t adc, int32_t tf, uint32_t *pres) {
+    int32_t var1, var2;
+    uint32_t p;
+
+    var1 = (((int32_t)tf) / 2) - (int32_t)64000;
+    var2 = (((var1/4) * (var1/4)) / 2048) * ((int32_t)BME280_calib.dig_P6);
+    var2 = var2 + ((var1 * ((int32_t)BME280_calib.dig_P5)) * 2);
+    var2 = (var2/4) + (((int32_t)BME280_calib.dig_P4) * 65536);
+    var1 = ((((int32_t)BME280_calib.dig_P3 * (((var1/4) * (var1/4)) / 8192)) / 8) +
+           ((((int32_t)BME280_calib.dig_P2) * var1)/2)) / 262144;
+    var1 = ((((32768 + var1)) * ((int32_t)BME280_calib.dig_P1)) / 32768);
+    if(var1 == 0)
+        return 0;
+
+    p = (((uint32_t)(((int32_t)1048576) - adc) - (var2 / 4096))) * 3125;
+    if(p < 0x80000000)
+        p = (p * 2) / ((uint32_t)var1);
+    else
+        p = (p / (uint32_t)var1) * 2;
+
+    var1 = (((int32_t)BME280_calib.dig_P9) * ((int32_t)(((p/8) * (p/8)) / 8192))) / 4096;
+    var2 = (((int32_t)(p/4)) * ((int32_t)BME280_calib.dig_P8)) / 8192;
+    *pres = (uint32_t)((int32_t)p + ((var1 + var2 + (int32_t)BME280_calib.dig_P7) / 16));
+
+    return 1;
+}
+
+#if USE_MUL_8X8
+// Cantos dos operandos: zero, um, extremos de 8, 16 e 32 bits
+static const uint32_t tst_cantos[] = {
+    0, 1, 2, 0x7F, 0x80, 0xFF, 0x100, 0x7FFF, 0x8000, 0x8001, 0xFFFF, 0x10000,
+    0x10001, 0x7FFFFFFF, 0x80000000, 0x80000001, 0xFFFF0000, 0xFFFF8000,
+    0xFFFFFF80, 0xFFFFFFFE, 0xFFFFFFFF
+};
+#define TST_CANTOS        (sizeof(tst_cantos) / sizeof(tst_cantos[0]))
+
+// Um par de operandos das multiplicações contra o produto de 64 bits
+static void TST_MulPair(uint32_t a, uint32_t b) {
+    uint32_t q;
+
+    q = MUL_16x16U((uint16_t)a, (uint16_t)b);
+    if(q != (uint32_t)(uint16_t)a * (uint16_t)b)
+        TST_Dif("MUL_16x16U", (uint16_t)a, (uint16_t)b, q, (uint32_t)(uint16_t)a * (uint16_t)b);
+
+    q = (uint32_t)MUL_32xU16((int32_t)a, (uint16_t)b);
+    if(q != (uint32_t)((uint64_t)a * (uint16_t)b))
+        TST_Dif("MUL_32xU16", (int32_t)a, (uint16_t)b, q, (uint32_t)((uint64_t)a * (uint16_t)b));
+
+    q = (uint32_t)MUL_32x16((int32_t)a, (int16_t)b);
+    if(q != (uint32_t)((int64_t)(int32_t)a * (int16_t)b))
+        TST_Dif("MUL_32x16", (int32_t)a, (int16_t)b, q, (uint32_t)((int64_t)(int32_t)a * (int16_t)b));
+
+    q = MUL_Square((int32_t)a);
+    if(q != (uint32_t)((uint64_t)a * a))
+        TST_Dif("MUL_Square", (int32_t)a, 0, q, (uint32_t)((uint64_t)a * a));
+
+    q = MUL_High32(a, b);
+    if(q != (uint32_t)(((uint64_t)a * b) >> 32))
+        TST_Dif("MUL_High32", a, b, q, (uint32_t)(((uint64_t)a * b) >> 32));
+}
+
+// Multiplicações da mult.c (as cinco rotinas conferidas juntas)
+static void TST_Mul(void) {
+    unsigned long i, j;
+    uint32_t a;
+
+    for(i = 0; i < TST_CANTOS; i++)
+        for(j = 0; j < TST_CANTOS; j++)
+            TST_MulPair(tst_cantos[i], tst_cantos[j]);
+
+    for(i = 0; i < TST_SORTEIOS; i++) {
+        a = TST_Random();
+        if(i & 1)                                                               // Metade com |a| de poucos bits (MUL_Square 16x16)
+            a = (i & 2) ? a >> (a & 31) : -(a >> (a & 31));
+        TST_MulPair(a, TST_Random());
+    }
+
+    TST_Fim("MUL_*", TST_CANTOS * TST_CANTOS + TST_SORTEIOS);
+}
+#endif
+
+// Prepara o divisor e o recíproco como BME280_PressureBase
+static void TST_Divisor(uint32_t d) {
+    bme280_p_div = d;
+    if(d > 1)
+        bme280_p_inv = BME280_Reciprocal(d);
+}
+
+// BME280_Divide contra a divisão do compilador
+static void TST_Div(void) {
+    unsigned long i;
+    uint32_t n, d, k;
+
+    for(i = 0; i < TST_SORTEIOS; i++) {
+        d = TST_Random() >> (TST_Random() & 31);
+        if(i < 64)                                                              // Potências de 2 e vizinhas
+            d = (uint32_t)(1UL << (i >> 1)) - (i & 1);
+        if(d == 0)
+            d = 1;
+        n = TST_Random();
+        k = n / d;
+        switch(i & 3) {
+            case 0: n = 0xFFFFFFFF - (i & 4); break;                            // Maior dividendo
+            case 1: n = k * d; break;                                           // Múltiplo exato
+            case 2: if(k) n = k * d - 1; break;                                 // Logo abaixo de um múltiplo
+        }
+
+        TST_Divisor(d);
+        if(BME280_Divide(n) != n / d)
+            TST_Dif("BME280_Divide", n, d, BME280_Divide(n), n / d);
+    }
+
+    bme280_p_div = 0;
+    TST_Fim("BME280_Divide", TST_SORTEIOS);
+}
+
+// Todos os coeficientes num extremo do tipo (sem sinal sempre no máximo)
+static void TST_Extremes(int16_t s16, int16_t s12, int8_t s8) {
+    BME280_calib.dig_T1 = 65535; BME280_calib.dig_T2 = s16; BME280_calib.dig_T3 = s16;
+    BME280_calib.dig_P1 = 65535; BME280_calib.dig_P2 = s16; BME280_calib.dig_P3 = s16;
+    BME280_calib.dig_P4 = s16;   BME280_calib.dig_P5 = s16; BME280_calib.dig_P6 = s16;
+    BME280_calib.dig_P7 = s16;   BME280_calib.dig_P8 = s16; BME280_calib.dig_P9 = s16;
+    BME280_calib.dig_H1 = 255;   BME280_calib.dig_H2 = s16; BME280_calib.dig_H3 = 255;
+    BME280_calib.dig_H4 = s12;   BME280_calib.dig_H5 = s12; BME280_calib.dig_H6 = s8;
+}
+
+// Calibração n: 0 do datasheet, 1 e 2 extremos, depois sorteadas
+static void TST_Calibration(unsigned int n) {
+    static const int32_t datasheet[18] = {
+        27504, 26435, -1000, 36477, -10685, 3024, 2855, 140, -7, 15500, -14600, 6000,
+        75, 370, 0, 313, 50, 30
+    };
+    int32_t c[18];
+    unsigned int i;
+
+    if(n == 1) {
+        TST_Extremes(-32768, -2048, -128);
+    } else if(n == 2) {
+        TST_Extremes(32767, 2047, 127);
+    } else {
+        for(i = 0; i < 18; i++)
+            c[i] = n == 0 ? datasheet[i] : (int32_t)TST_Random();
+        // Sorteados cortados na largura de cada coeficiente
+        BME280_calib.dig_T1 = (uint16_t)c[0];  BME280_calib.dig_T2 = (int16_t)c[1];
+        BME280_calib.dig_T3 = (int16_t)c[2];   BME280_calib.dig_P1 = (uint16_t)c[3];
+        BME280_calib.dig_P2 = (int16_t)c[4];   BME280_calib.dig_P3 = (int16_t)c[5];
+        BME280_calib.dig_P4 = (int16_t)c[6];   BME280_calib.dig_P5 = (int16_t)c[7];
+        BME280_calib.dig_P6 = (int16_t)c[8];   BME280_calib.dig_P7 = (int16_t)c[9];
+        BME280_calib.dig_P8 = (int16_t)c[10];  BME280_calib.dig_P9 = (int16_t)c[11];
+        BME280_calib.dig_H1 = (uint8_t)c[12];  BME280_calib.dig_H2 = (int16_t)c[13];
+        BME280_calib.dig_H3 = (uint8_t)c[14];
+        BME280_calib.dig_H4 = (int16_t)(c[15] << 4) >> 4;                       // 12 bits com sinal
+        BME280_calib.dig_H5 = (int16_t)(c[16] << 4) >> 4;
+        BME280_calib.dig_H6 = (int8_t)c[17];
+    }
+
+    BME280_Invalidate(BME280_CANAL_T | BME280_CANAL_H | BME280_CANAL_P | BME280_CALIBRACAO);
+}
+
+// Todo adc_T; todo adc_H e todo adc_P em TST_TFINE temperaturas
+static void TST_Compensation(void) {
+    unsigned long long casos = 0;
+    unsigned int n, i;
+    int32_t t, tr, tf;
+    uint32_t v, vr;
+    uint8_t ok, okr;
+
+    for(n = 0; n < 3 + TST_CALIBRACOES; n++) {
+        TST_Calibration(n);
+
+        for(adc_T = 0; adc_T < 0x100000; adc_T++) {
+            BME280_Invalidate(BME280_CANAL_T);
+            ReadTemperature(&t);
+            tr = TST_Temperature(adc_T, &tf);
+            if(t != tr || t_fine != tf)
+                TST_Dif("Temperatura", n, adc_T, t, tr);
+        }
+        casos += 0x100000;
+
+        for(i = 0; i < TST_TFINE; i++) {
+            adc_T = (0x100000 / TST_TFINE) * i + 0x1234;                        // Espalha t_fine pela faixa do ADC
+            BME280_Invalidate(BME280_CANAL_T);
+            ReadTemperature(&t);
+            TST_Temperature(adc_T, &tf);
+
+            for(adc_H = 0; adc_H < 0x10000; adc_H++) {
+                BME280_Invalidate(BME280_CANAL_H);
+                ReadHumidity(&v);
+                vr = TST_Humidity(adc_H, tf);
+                if(v != vr)
+                    TST_Dif("Umidade", n, adc_H, v, vr);
+            }
+
+            for(adc_P = 0; adc_P < 0x100000; adc_P++) {                         // Parte fixa e recíproco guardados
+                BME280_Invalidate(BME280_CANAL_P);
+                ok = ReadPressure(&v);
+                okr = TST_Pressure(adc_P, tf, &vr);
+                if(ok != okr || (ok && v != vr))
+                    TST_Dif("Pressao", n, adc_P, ok ? (long long)v : -1, okr ? (long long)vr : -1);
+            }
+            casos += 0x10000 + 0x100000;
+        }
+    }
+
+    TST_Fim("Compensacao", casos);
+}
+
+// Grava um bruto de 20 bits (P, T) ou 16 bits (H) nos registradores
+static void TST_Raw(uint8_t reg, uint32_t valor, uint8_t bytes) {
+    if(bytes == 3) {
+        tst_reg[reg] = (uint8_t)(valor >> 12);
+        tst_reg[reg + 1] = (uint8_t)(valor >> 4);
+        tst_reg[reg + 2] = (uint8_t)(valor << 4);
+    } else {
+        tst_reg[reg] = (uint8_t)(valor >> 8);
+        tst_reg[reg + 1] = (uint8_t)valor;
+    }
+}
+
+// Brutos mudando um canal por vez ou juntos, leituras em ordem sorteada
+static void TST_Lazy(void) {
+    uint32_t t = 0x80000, p = 0x50000, h = 0x6000, r, v, vr;
+    int32_t temp, tr, tf;
+    unsigned long i;
+    uint8_t j, ordem, ok, okr;
+
+    TST_Calibration(0);
+    for(i = 0; i < TST_PASSOS; i++) {
+        r = TST_Random();
+        if((r & 0xFFFF) == 0)                                                   // Calibração trocada (raro)
+            TST_Calibration(3 + (r >> 16) % TST_CALIBRACOES);
+        if(r & 0x10000)                                                         // Cada canal muda com chance 1/2
+            t = (r & 0x20000) ? (t + (TST_Random() & 0xFF) - 0x80) & 0xFFFFF : TST_Random() & 0xFFFFF;
+        if(r & 0x40000)
+            p = (r & 0x80000) ? (p + (TST_Random() & 0xFF) - 0x80) & 0xFFFFF : TST_Random() & 0xFFFFF;
+        if(r & 0x100000)
+            h = (r & 0x200000) ? (h + (TST_Random() & 0xFF) - 0x80) & 0xFFFF : TST_Random() & 0xFFFF;
+
+        TST_Raw(BME280_REG_PRESS_MSB, p, 3);
+        TST_Raw(BME280_REG_PRESS_MSB + 3, t, 3);
+        TST_Raw(BME280_REG_PRESS_MSB + 6, h, 2);
+        BME280_Update();
+
+        TST_Temperature(t, &tf);
+        ordem = (uint8_t)((r >> 22) % 6);                                       // Ordem das leituras; às vezes pula algumas
+        for(j = 0; j < 3; j++) {
+            switch((ordem + j * ((r >> 25 & 1) + 1)) % 3) {
+                case 0:
+                    if(r & 0x10000000) break;
+                    ReadTemperature(&temp);
+                    tr = TST_Temperature(t, &tf);
+                    if(temp != tr)
+                        TST_Dif("Temperatura", i, t, temp, tr);
+                    break;
+                case 1:
+                    if(r & 0x20000000) break;
+                    ReadHumidity(&v);
+                    vr = TST_Humidity(h, tf);
+                    if(v != vr)
+                        TST_Dif("Umidade", i, h, v, vr);
+                    break;
+                case 2:
+                    if(r & 0x40000000) break;
+                    ok = ReadPressure(&v);
+                    okr = TST_Pressure(p, tf, &vr);
+                    if(ok != okr || (ok && v != vr))
+                        TST_Dif("Pressao", i, p, ok ? (long long)v : -1, okr ? (long long)vr : -1);
+                    break;
+            }
+        }
+
+        // Depois das três leituras, repetir os brutos não deixa canal sujo
+        if(!(r & 0x70000000)) {
+            BME280_Update();
+            if(bme280_sujos)
+                TST_Dif("Sujos", i, bme280_sujos, bme280_sujos, 0);
+        }
+    }
+
+    TST_Fim("Sob demanda", TST_PASSOS);
+}
+
+int main(void) {
+#if USE_MUL_8X8
+    TST_Mul();
+#endif
+    TST_Div();
+    TST_Compensation();
+    TST_Lazy();
+
+    printf(tst_erros ? "FALHOU: %u testes\n" : "OK\n", tst_erros);
+    return tst_erros != 0;
+}
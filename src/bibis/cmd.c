@@ -0,0 +1,456 @@
+/******************************************************************************
+ * Biblioteca: Comandos pela serial (cmd.c)
+ * Autor: Elison Nogueira
+ * Data: 18/10/2026
+ * Versão: 1.0
+ * Plataforma: PIC18F25K50 (Microchip)
+ * Compilador: mikroC Pro for PIC v7.6.0
+ *
+ * Descrição:
+ * Recepção de linhas pela UART1 e interpretação dos comandos GET, SET,
+ * SAVE, LOAD, TUNE, STAT, HIST, PERF e WCET. Veja cmd.h.
+ ******************************************************************************/
+
+#include "cmd.h"
+#include "bme280.h"
+#include "ajustes.h"
+#include "adaptativo.h"
+#include "unidades.h"
+#include "interface.h"
+#include "vario.h"
+#include "rtc.h"
+#include "sched.h"
+#include "historico.h"
+#include "perf.h"
+#include "wcet.h"
+
+char cmd_linha[CMD_TAM_LINHA + 1];                                              // Linha recebida
+volatile unsigned char cmd_tam;                                                 // Caracteres na linha
+volatile unsigned char cmd_pronta;                                              // 1 = linha completa aguardando CMD_Task
+volatile unsigned char cmd_recebeu;                                             // 1 = chegou caractere desde a última CMD_Task
+unsigned long cmd_ultimo;                                                       // Timestamp do último tráfego
+volatile unsigned char cmd_excedeu;                                             // 1 = linha maior que o buffer
+char cmd_texto[56];                                                             // Buffer da resposta
+
+// Nomes dos slots de perf.h, na ordem dos índices
+#define CMD_PERF_NOME(nome, funcao)   #nome,
+const char cmd_perf_nomes[PERF_QTD][12] = {
+    "LCD_FRIO", "LCD_QUENTE", "VARIO", PIPE_ESTAGIOS(CMD_PERF_NOME)             // Estágios da cadeia (pipeline.h)
+#if USE_CONST_TIME
+    "COMP_LIVRE"
+#endif
+};
+
+#if USE_WCET
+// Nomes das funções de wcet.h, na ordem dos índices
+const char cmd_wcet_nomes[WCET_QTD][3] = {"T", "H", "P", "PC"};
+const char cmd_wcet_muls[WCET_MULS][8] = {"M32x16", "M32xU16", "M16x16U", "MLONG"};
+#endif
+
+// Configura a UART1 e habilita a interrupção de recepção
+void CMD_Init(void) {
+    ANSELC &= ~0xC0;                                                            // RC6/RC7 digitais
+    UART1_Init(CMD_BAUD);
+    Delay_ms(100);                                                              // Estabilização do módulo
+
+    cmd_tam = 0;
+    cmd_pronta = 0;
+    cmd_excedeu = 0;
+    cmd_recebeu = 0;
+    cmd_ultimo = RTC_Now();
+
+    RCIE_bit = 1;
+    PEIE_bit = 1;
+    GIE_bit = 1;
+}
+
+// Acumula os caracteres recebidos até o fim da linha
+void CMD_Isr(void) {
+    char c;
+
+    if(RCIF_bit && RCIE_bit) {
+        c = RCREG1;                                                             // Leitura limpa o RCIF
+        if(OERR_bit) {                                                          // Sobrecarga trava a recepção
+            CREN_bit = 0;
+            CREN_bit = 1;
+        }
+
+        cmd_recebeu = 1;
+        if(cmd_pronta || c == 0)                                                // Linha anterior não tratada ou byte do WUE
+            return;
+
+        if(c == '\r' || c == '\n') {
+            if(cmd_tam || cmd_excedeu) {                                        // Ignora linhas vazias (CR+LF)
+                cmd_linha[cmd_tam] = 0;
+                cmd_pronta = 1;
+            }
+        } else if(cmd_tam < CMD_TAM_LINHA) {
+            cmd_linha[cmd_tam++] = c;
+        } else {
+            cmd_excedeu = 1;
+        }
+    }
+}
+
+// Envia um texto seguido de CR+LF
+void CMD_Send(char *s) {
+    UART1_Write_Text(s);
+    UART1_Write('\r');
+    UART1_Write('\n');
+}
+
+// Envia OK ou ERR
+static void CMD_Reply(unsigned char ok) {
+    if(ok)
+        CMD_Send("OK");
+    else
+        CMD_Send("ERR");
+}
+
+// Compara s com uma palavra (1 = iguais)
+static unsigned char CMD_Is(char *s, const char *palavra) {
+    while(*palavra)
+        if(*s++ != *palavra++)
+            return 0;
+
+    return *s == 0;
+}
+
+// Converte um decimal de até 3 dígitos; retorna 0 se inválido
+static unsigned char CMD_Number(char *s, unsigned char *valor) {
+    unsigned int v;
+    unsigned char n;
+
+    v = 0;
+    for(n = 0; s[n]; n++) {
+        if(s[n] < '0' || s[n] > '9' || n == 3)
+            return 0;
+        v = (unsigned int)(v * 10 + (s[n] - '0'));
+    }
+    if(n == 0 || v > 255)
+        return 0;
+
+    *valor = (unsigned char)v;
+    return 1;
+}
+
+// Fator do código do sensor: oversampling (extra = 0) ou filtro (extra = 1)
+static unsigned char CMD_Scale(unsigned char codigo, unsigned char extra) {
+    return codigo ? 1 << (codigo - 1 + extra) : 0;
+}
+
+// Procura o código cujo fator é igual a valor; retorna 0 se não houver
+static unsigned char CMD_Code(unsigned char valor, unsigned char extra,
+                              unsigned char qtd, unsigned char *codigo) {
+    unsigned char c;
+
+    for(c = 0; c < qtd; c++) {
+        if(CMD_Scale(c, extra) == valor) {
+            *codigo = c;
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+// Aplica oversampling e filtro dos ajustes, mantendo modo e standby do nível
+static void CMD_ApplySensor(void) {
+    BME280_Configure(BME280_cfg.mode, ajustes.osrs_t, ajustes.osrs_h,
+                     ajustes.osrs_p, ajustes.filtro, BME280_cfg.standby);
+    ADPT_Resync();                                                              // O ciclo do modo normal mudou
+    UI_Refresh();
+}
+
+// Aplica as unidades dos ajustes
+static void CMD_ApplyUnits(void) {
+    UN_Select(ajustes.un_temp, ajustes.un_pres, ajustes.un_umid);
+    UI_UnitsChanged();
+}
+
+// Trata "SET chave=valor"; retorna 1 se aplicado
+static unsigned char CMD_Set(char *s) {
+    char *v;
+    unsigned char n;
+
+    for(v = s; *v && *v != '='; v++);
+    if(*v == 0)
+        return 0;
+    *v++ = 0;                                                                   // Separa chave e valor
+
+    if(CMD_Is(s, "N")) {
+        if(CMD_Is(v, "A"))
+            n = ADPT_AUTOMATICO;
+        else if(!CMD_Number(v, &n) || n >= ADPT_NIVEIS)
+            return 0;
+        if(VAR_Active())
+            return 0;
+        ajustes.nivel = n;
+        ADPT_Lock(n);
+        UI_Refresh();
+        return 1;
+    }
+
+    if(!CMD_Number(v, &n))
+        return 0;
+
+    if(CMD_Is(s, "L")) {
+        ajustes.luz = n;                                                        // A interface lê o tempo a cada passagem
+        return 1;
+    }
+
+    if(CMD_Is(s, "UT")) {
+        if(n >= UN_T_QTD) return 0;
+        ajustes.un_temp = n;
+    } else if(CMD_Is(s, "UP")) {
+        if(n >= UN_P_QTD) return 0;
+        ajustes.un_pres = n;
+    } else if(CMD_Is(s, "UU")) {
+        if(n >= UN_H_QTD) return 0;
+        ajustes.un_umid = n;
+    } else {
+        if(VAR_Active())                                                        // O variômetro restauraria a configuração antiga
+            return 0;
+        if(CMD_Is(s, "T")) {
+            if(!CMD_Code(n, 0, 6, &ajustes.osrs_t)) return 0;
+        } else if(CMD_Is(s, "H")) {
+            if(!CMD_Code(n, 0, 6, &ajustes.osrs_h)) return 0;
+        } else if(CMD_Is(s, "P")) {
+            if(!CMD_Code(n, 0, 6, &ajustes.osrs_p)) return 0;
+        } else if(CMD_Is(s, "F")) {
+            if(!CMD_Code(n, 1, 5, &ajustes.filtro)) return 0;
+        } else {
+            return 0;
+        }
+        CMD_ApplySensor();
+        return 1;
+    }
+
+    CMD_ApplyUnits();
+    return 1;
+}
+
+// Acrescenta " chave=valor" à resposta
+static void CMD_Pair(const char *chave, unsigned char valor) {
+    unsigned char n;
+
+    n = UN_Cat(cmd_texto, chave);
+    UN_FmtUInt(cmd_texto + n, valor);
+}
+
+// Envia a linha de ajustes (resposta do GET)
+void CMD_Report(void) {
+    unsigned char n;
+
+    cmd_texto[0] = 0;
+    CMD_Pair("T=", CMD_Scale(ajustes.osrs_t, 0));
+    CMD_Pair(" H=", CMD_Scale(ajustes.osrs_h, 0));
+    CMD_Pair(" P=", CMD_Scale(ajustes.osrs_p, 0));
+    CMD_Pair(" F=", CMD_Scale(ajustes.filtro, 1));
+    n = UN_Cat(cmd_texto, " N=");
+    if(ajustes.nivel < ADPT_NIVEIS)
+        cmd_texto[n++] = '0' + ajustes.nivel;
+    else
+        cmd_texto[n++] = 'A';
+    cmd_texto[n] = 0;
+    CMD_Pair(" UT=", ajustes.un_temp);
+    CMD_Pair(" UP=", ajustes.un_pres);
+    CMD_Pair(" UU=", ajustes.un_umid);
+    CMD_Pair(" L=", ajustes.luz);
+#if USE_CONST_TIME
+    n = UN_Cat(cmd_texto, " ORC=");                                             // Orçamento medido pelo WCET (0 = sem espera)
+    UN_FmtUInt(cmd_texto + n, ajustes.orcamento);
+#endif
+
+    CMD_Send(cmd_texto);
+}
+
+// Envia a ociosidade e a taxa efetiva de amostras
+static void CMD_Stat(void) {
+    unsigned char n;
+
+    cmd_texto[0] = 0;
+    n = UN_Cat(cmd_texto, "IDLE=");
+    n += UN_FmtDec(cmd_texto + n, (long)SCH_IdleRate() * 10, 1);                // Por mil em centésimos de %
+    n = UN_Cat(cmd_texto, "% TAXA=");
+    n += UN_FmtDec(cmd_texto + n, SCH_SampleRate(), 2);
+    n = UN_Cat(cmd_texto, "/s NOVAS=");
+    n += UN_FmtUInt(cmd_texto + n, BME280_NewCount());
+    n = UN_Cat(cmd_texto, " REPET=");
+    UN_FmtUInt(cmd_texto + n, BME280_RepeatCount());
+
+    CMD_Send(cmd_texto);
+}
+
+// Envia o histórico, da amostra mais antiga para a mais recente, e OK no fim
+static void CMD_History(void) {
+    unsigned char i, n;
+    amostra_bme280 *a;
+
+    for(i = HIST_Count(); i--; ) {
+        a = HIST_Get(i);
+        n = UN_FmtUInt(cmd_texto, a->ts >> 12);                                 // Segundos desde a partida
+        cmd_texto[n++] = ' ';
+        n += UN_FmtDec(cmd_texto + n, a->temperatura, 2);
+        cmd_texto[n++] = ' ';
+        n += UN_FmtDec(cmd_texto + n, (a->umidade * 25) >> 8, 2);              // 1/1024 % -> 1/100 %
+        cmd_texto[n++] = ' ';
+        UN_FmtUInt(cmd_texto + n, a->pressao);
+        CMD_Send(cmd_texto);
+    }
+
+    CMD_Reply(1);
+}
+
+// Envia uma linha por slot de medida: última e maior (us)
+static void CMD_Perf(void) {
+    unsigned char i, n;
+
+    for(i = 0; i < PERF_QTD; i++) {
+        cmd_texto[0] = 0;
+        UN_Cat(cmd_texto, cmd_perf_nomes[i]);
+        n = UN_Cat(cmd_texto, "=");
+        n += UN_FmtUInt(cmd_texto + n, PERF_Last(i));
+        n = UN_Cat(cmd_texto, "us MAX=");
+        n += UN_FmtUInt(cmd_texto + n, PERF_Max(i));
+        UN_Cat(cmd_texto, "us");
+        CMD_Send(cmd_texto);
+    }
+
+    CMD_Reply(1);
+}
+
+#if USE_WCET
+// Varre a compensação e envia o pior caso de cada função com a entrada
+static void CMD_Wcet(void) {
+    wcet_caso *c;
+    unsigned char i, n;
+
+    WCET_Run();
+
+    for(i = 0; i < WCET_QTD; i++) {
+        c = WCET_Get(i);
+        cmd_texto[0] = 0;
+        UN_Cat(cmd_texto, cmd_wcet_nomes[i]);
+        n = UN_Cat(cmd_texto, "=");
+        n += UN_FmtUInt(cmd_texto + n, c->us);
+        n = UN_Cat(cmd_texto, "us S=");
+        n += UN_FmtUInt(cmd_texto + n, c->conjunto);
+        n = UN_Cat(cmd_texto, " AT=");
+        n += UN_FmtUInt(cmd_texto + n, c->adc_T);
+        n = UN_Cat(cmd_texto, " AP=");
+        n += UN_FmtUInt(cmd_texto + n, c->adc_P);
+        n = UN_Cat(cmd_texto, " AH=");
+        UN_FmtUInt(cmd_texto + n, c->adc_H);
+        CMD_Send(cmd_texto);
+    }
+
+    for(i = 0; i < WCET_MULS; i++) {
+        cmd_texto[0] = 0;
+        UN_Cat(cmd_texto, cmd_wcet_muls[i]);
+        n = UN_Cat(cmd_texto, "=");
+        n += UN_FmtUInt(cmd_texto + n, WCET_MulCycles(i));
+        UN_Cat(cmd_texto, "c");
+        CMD_Send(cmd_texto);
+    }
+
+#if USE_CONST_TIME
+    // Estágio COMPENSACAO nivelado: CT=menor..maiorus ORC=us ESPERA=médiaus EST=n
+    cmd_texto[0] = 0;
+    n = UN_Cat(cmd_texto, "CT=");
+    n += UN_FmtUInt(cmd_texto + n, WCET_Level()->min);
+    n = UN_Cat(cmd_texto, "..");
+    n += UN_FmtUInt(cmd_texto + n, WCET_Level()->max);
+    n = UN_Cat(cmd_texto, "us ORC=");
+    n += UN_FmtUInt(cmd_texto + n, ajustes.orcamento);
+    n = UN_Cat(cmd_texto, "us ESPERA=");
+    n += UN_FmtUInt(cmd_texto + n, WCET_Level()->espera);
+    n = UN_Cat(cmd_texto, "us EST=");
+    UN_FmtUInt(cmd_texto + n, WCET_Level()->estouros);
+    CMD_Send(cmd_texto);
+#endif
+
+    CMD_Reply(1);
+}
+#endif
+
+// Interpreta a linha recebida; retorna um pedido ao laço principal
+static unsigned char CMD_Execute(void) {
+    char *arg;
+
+    for(arg = cmd_linha; *arg && *arg != ' '; arg++);                           // Separa o comando do argumento
+    if(*arg)
+        *arg++ = 0;
+
+    if(CMD_Is(cmd_linha, "GET")) {
+        CMD_Report();
+    } else if(CMD_Is(cmd_linha, "SET")) {
+        CMD_Reply(CMD_Set(arg));
+    } else if(CMD_Is(cmd_linha, "STAT")) {
+        CMD_Stat();
+    } else if(CMD_Is(cmd_linha, "HIST")) {
+        CMD_History();
+    } else if(CMD_Is(cmd_linha, "PERF")) {
+        CMD_Perf();
+    } else if(CMD_Is(cmd_linha, "SAVE")) {
+        AJS_Save();
+        CMD_Reply(1);
+    } else if(VAR_Active()) {                                                   // LOAD, TUNE e WCET mexem no sensor
+        CMD_Reply(0);
+#if USE_WCET
+    } else if(CMD_Is(cmd_linha, "WCET")) {
+        CMD_Wcet();
+#endif
+    } else if(CMD_Is(cmd_linha, "LOAD")) {
+        CMD_Reply(AJS_Load());                                                  // Bloco inválido carrega o padrão
+        CMD_ApplySensor();
+        CMD_ApplyUnits();
+        ADPT_Lock(ajustes.nivel);
+    } else if(CMD_Is(cmd_linha, "TUNE")) {
+        CMD_Reply(1);
+        return CMD_PEDE_AJUSTE;
+    } else {
+        CMD_Reply(0);
+    }
+
+    return CMD_NADA;
+}
+
+// Trata a linha recebida, se houver; retorna um pedido ao laço principal
+unsigned char CMD_Task(void) {
+    unsigned char i, pedido;
+
+    if(cmd_recebeu) {                                                           // Renova a janela de escuta
+        cmd_recebeu = 0;
+        cmd_ultimo = RTC_Now();
+    }
+
+    if(!cmd_pronta)
+        return CMD_NADA;
+
+    pedido = CMD_NADA;
+    if(cmd_excedeu) {
+        CMD_Reply(0);
+    } else {
+        for(i = 0; cmd_linha[i]; i++)                                           // Comandos sem distinção de caixa
+            if(cmd_linha[i] >= 'a' && cmd_linha[i] <= 'z')
+                cmd_linha[i] -= 'a' - 'A';
+        pedido = CMD_Execute();
+    }
+
+    cmd_tam = 0;
+    cmd_excedeu = 0;
+    cmd_pronta = 0;                                                             // Libera a recepção por último
+
+    return pedido;
+}
+
+// Retorna 1 se há linha completa aguardando CMD_Task
+unsigned char CMD_Pending(void) {
+    return cmd_pronta;
+}
+
+// Retorna 1 se houve tráfego na serial nos últimos CMD_ESCUTA ticks
+unsigned char CMD_Listening(void) {
+    return cmd_recebeu || cmd_tam || (RTC_Now() - cmd_ultimo) < CMD_ESCUTA;
+}
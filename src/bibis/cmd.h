@@ -0,0 +1,86 @@
+/******************************************************************************
+ * Biblioteca: Comandos pela serial (cmd.h)
+ * Autor: Elison Nogueira
+ * Data: 18/10/2026
+ * Versão: 1.0
+ * Plataforma: PIC18F25K50 (Microchip)
+ * Compilador: mikroC Pro for PIC v7.6.0
+ *
+ * Descrição:
+ * Protocolo de linhas em ASCII pela UART1 (RC6 = TX, RC7 = RX, 19200 8N1)
+ * para ler e alterar a configuração sem regravar o firmware. Cada linha
+ * termina em CR ou LF; maiúsculas e minúsculas são equivalentes.
+ *
+ *   Comando        Efeito                                       Resposta
+ *   GET            Lê os ajustes atuais                         T=.. H=.. P=.. F=.. N=.. UT=.. UP=.. UU=.. L=.. [ORC=..]
+ *   SET k=v        Altera um ajuste e aplica na hora            OK ou ERR
+ *   SAVE           Grava os ajustes na EEPROM                   OK
+ *   LOAD           Volta aos ajustes gravados na EEPROM         OK ou ERR (bloco inválido, usa o padrão)
+ *   TUNE           Refaz o auto-ajuste e grava                  OK e depois a linha do GET
+ *   STAT           Ociosidade e leituras novas/s na última      IDLE=..% TAXA=../s
+ *                  janela (sched.h); contadores de leituras     NOVAS=.. REPET=..
+ *                  novas e repetidas (bme280.c, módulo 65536)
+ *   HIST           Descarrega o histórico (historico.h), da     s T UR P por linha e OK
+ *                  amostra mais antiga para a mais recente
+ *   PERF           Tempos medidos no Timer0 (perf.h)            nome=..us MAX=..us por slot e OK
+ *   WCET           Pior caso da compensação e ciclos das        f=..us S=.. AT=.. AP=.. AH=..
+ *                  multiplicações (wcet.h, só com USE_WCET);    por função, Mrotina=..c por
+ *                  leva alguns segundos; com USE_CONST_TIME     multiplicação, CT=..us ORC=..us
+ *                  também mede o orçamento e o estágio com a    ESPERA=..us EST=.. e OK
+ *                  espera (wcet.h); SAVE grava o orçamento
+ *
+ *   Chave  Valores                      Aplicado por
+ *   T H P  Oversampling 0,1,2,4,8,16    BME280_Configure (mantém modo e standby)
+ *   F      Filtro IIR 0,2,4,8,16        BME280_Configure
+ *   N      Nível 0..3 fixo ou A (auto)  ADPT_Lock (modo, standby e período)
+ *   UT     0 = °C, 1 = °F, 2 = K        UN_Select
+ *   UP     0 = hPa, 1 = inHg, 2 = mmHg  UN_Select
+ *   UU     0 = % UR, 1 = g/m³           UN_Select
+ *   L      Backlight 0..255 s, 0 = fixo Política da interface (interface.h)
+ *
+ * O standby não é um ajuste próprio: ele pertence ao nível da amostragem
+ * adaptativa (adaptativo.h); fixar N escolhe modo, standby e período juntos.
+ * SET não grava na EEPROM; use SAVE quando a configuração estiver boa.
+ * ORC só aparece com USE_CONST_TIME: é o orçamento do tempo constante em us
+ * (pipeline.h), que só o WCET altera; 0 quer dizer que nunca foi medido.
+ * Enquanto o variômetro estiver ativo, os ajustes do sensor são recusados.
+ *
+ * A recepção é feita na interrupção (CMD_Isr) direto no buffer de linha,
+ * então nada se perde enquanto o laço principal espera o sensor. A linha
+ * só é interpretada em CMD_Task; a resposta é enviada com escrita bloqueante
+ * (~0.5ms por caractere). No HIST cada linha traz o instante em segundos
+ * desde a partida, T em °C, UR em % e P em Pa; 32 linhas (perfil sem
+ * display) levam ~0.4s e atrasam a leitura seguinte.
+ *
+ * Com a serial quieta por CMD_ESCUTA o escalonador pode entrar em SLEEP
+ * (sched.h). A borda do primeiro caractere acorda a CPU e esse caractere
+ * se perde; mande um CR antes do comando (linhas vazias são ignoradas).
+ * Depois disso a CPU só usa IDLE até a serial ficar quieta de novo.
+ *
+ * Recepção e SET conferidos no host em cmd_teste.c (teste_host.py).
+ *
+ * Dependências:
+ * - Biblioteca UART do mikroC PRO for PIC
+ *****************************************************************************/
+
+#ifndef CMD_H
+#define CMD_H
+
+#define CMD_BAUD          19200
+#define CMD_ESCUTA        (5 * RTC_HZ)                                          // Serial quieta por 5s libera o SLEEP
+#define CMD_TAM_LINHA     24                                                    // Caracteres por linha (sem o terminador)
+
+// Pedidos ao laço principal (retorno de CMD_Task)
+#define CMD_NADA          0
+#define CMD_PEDE_AJUSTE   1                                                     // Refazer o auto-ajuste
+
+// Protótipos das funções
+void CMD_Init(void);                                                            // Configura a UART1 e a interrupção de recepção
+void CMD_Isr(void);                                                             // Recebe caracteres (chamar na interrupção)
+unsigned char CMD_Pending(void);                                                // 1 = linha recebida aguardando CMD_Task
+unsigned char CMD_Listening(void);                                              // 1 = tráfego recente (a UART precisa de clock)
+void CMD_Send(char *s);                                                         // Envia uma linha (CR+LF no fim)
+unsigned char CMD_Task(void);                                                   // Interpreta a linha recebida; retorna um pedido
+void CMD_Report(void);                                                          // Envia a linha de ajustes (resposta do GET)
+
+#endif
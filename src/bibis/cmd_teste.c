@@ -0,0 +1,433 @@
+/******************************************************************************
+ * Teste no host: Recepção e interpretação dos comandos (cmd_teste.c)
+ * Autor: Elison Nogueira
+ * Data: 18/10/2026
+ * Versão: 1.0
+ * Plataforma: PC (gcc)
+ *
+ * Descrição:
+ * Compila o cmd.c e o unidades.c do firmware com a UART e os módulos
+ * vizinhos substituídos e confere:
+ *
+ *   Teste         Verifica
+ *   CMD_Number    Todo texto de 1 a 4 dígitos (com zeros à esquerda), vazio
+ *                 e com caracteres fora de 0..9: aceita só 1 a 3 dígitos
+ *                 com valor até 255
+ *   CMD_Code      Todo valor de 0 a 255 nos dois usos: oversampling aceita
+ *                 0,1,2,4,8,16 (códigos 0..5) e filtro 0,2,4,8,16 (0..4)
+ *   CMD_Isr       Linhas entregues byte a byte na interrupção: CR, LF e
+ *                 CR+LF, linhas vazias, byte 0 do WUE, sobrecarga (OERR),
+ *                 linha de CMD_TAM_LINHA caracteres aceita e uma a mais
+ *                 recusada (ERR) sem sobrar nada para a linha seguinte, e
+ *                 bytes que chegam antes de CMD_Task tratar a anterior
+ *   CMD_Set       Tabela de linhas com a resposta e o efeito esperados:
+ *                 chaves válidas e inválidas, SET sem '=', valor vazio ou
+ *                 de 4 dígitos, códigos de oversampling e filtro, nível e
+ *                 unidades fora da faixa, caixa baixa e variômetro ativo
+ *
+ * Um ERR nunca pode mexer nos ajustes nem no sensor: depois de cada linha
+ * recusada o teste compara os ajustes e o número de BME280_Configure com
+ * os de antes.
+ *
+ * Não compila sozinho: teste_host.py copia o cmd.c e o unidades.c com os
+ * tipos do mikroC e compila este arquivo contra eles (veja lá).
+ *
+ * Uso: python3 teste_host.py cmd
+ * Sai com 1 se alguma verificação falhar.
+ *****************************************************************************/
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+
+// Registradores e bibliotecas do mikroC usados pelo cmd.c
+uint8_t ANSELC, RCREG1;
+uint8_t RCIF_bit, RCIE_bit, PEIE_bit, GIE_bit, OERR_bit, CREN_bit;
+
+void UART1_Init(uint32_t baud);
+void UART1_Write(char c);
+void UART1_Write_Text(char *s);
+void Delay_ms(unsigned ms);
+
+#include "unidades_host.c"
+#include "cmd_host.c"
+
+char tst_saida[512];                                                            // Texto enviado pela UART
+unsigned int tst_tam;
+
+void UART1_Init(uint32_t baud) { }
+void Delay_ms(unsigned ms) { }
+
+void UART1_Write(char c) {
+    if(tst_tam < sizeof(tst_saida) - 1)
+        tst_saida[tst_tam++] = c;
+    tst_saida[tst_tam] = 0;
+}
+
+void UART1_Write_Text(char *s) {
+    while(*s)
+        UART1_Write(*s++);
+}
+
+// Substitutos dos módulos vizinhos: só registram o que o cmd.c pediu
+config_bme280 BME280_cfg;
+ajustes_cfg ajustes;
+unsigned int tst_configura, tst_tranca, tst_carrega, tst_grava;
+uint8_t tst_vario, tst_nivel;
+
+void BME280_Configure(bme280_mode mode, bme280_sampling osrs_t, bme280_sampling osrs_h,
+                      bme280_sampling osrs_p, bme280_filter filter, standby_time sb) {
+    BME280_cfg.mode = mode;
+    BME280_cfg.T_sampling = osrs_t;
+    BME280_cfg.H_sampling = osrs_h;
+    BME280_cfg.P_sampling = osrs_p;
+    BME280_cfg.filter = filter;
+    BME280_cfg.standby = sb;
+    tst_configura++;
+}
+
+void ADPT_Lock(uint8_t nivel) {
+    tst_nivel = nivel;
+    tst_tranca++;
+}
+
+uint8_t AJS_Load(void) {
+    tst_carrega++;
+    return 1;
+}
+
+void AJS_Save(void)                 { tst_grava++; }
+void ADPT_Resync(void)              { }
+void UI_Refresh(void)               { }
+void UI_UnitsChanged(void)          { }
+uint8_t VAR_Active(void)            { return tst_vario; }
+uint32_t RTC_Now(void)              { return 0; }
+uint16_t SCH_IdleRate(void)         { return 0; }
+uint16_t SCH_SampleRate(void)       { return 0; }
+uint16_t BME280_NewCount(void)      { return 0; }
+uint16_t BME280_RepeatCount(void)   { return 0; }
+uint8_t HIST_Count(void)            { return 0; }
+amostra_bme280 *HIST_Get(uint8_t i) { return 0; }
+uint16_t PERF_Last(uint8_t slot)    { return 0; }
+uint16_t PERF_Max(uint8_t slot)     { return 0; }
+
+unsigned int tst_erros;
+
+static void TST_Fim(const char *teste, unsigned int casos, unsigned int falhas) {
+    printf("%-12s %6u casos  %s\n", teste, casos, falhas ? "FALHOU" : "ok");
+    if(falhas)
+        tst_erros++;
+}
+
+// Ajustes de partida: x1 em tudo, sem filtro, nível automático
+static void TST_Defaults(void) {
+    memset(&ajustes, 0, sizeof(ajustes));
+    ajustes.osrs_t = ajustes.osrs_h = ajustes.osrs_p = 1;
+    ajustes.nivel = ADPT_AUTOMATICO;
+    ajustes.luz = 30;
+    UN_Select(0, 0, 0);
+    tst_vario = 0;
+}
+
+// Entrega os bytes na interrupção, como a UART faria
+static void TST_Receive(const char *s, unsigned int n) {
+    while(n--) {
+        RCREG1 = (uint8_t)*s++;
+        RCIF_bit = 1;
+        CMD_Isr();
+        RCIF_bit = 0;
+    }
+}
+
+// Recebe a linha, roda CMD_Task e devolve o que foi enviado
+static const char *TST_Line(const char *s) {
+    tst_tam = 0;
+    tst_saida[0] = 0;
+    TST_Receive(s, (unsigned int)strlen(s));
+    CMD_Task();
+    return tst_saida;
+}
+
+// Compara a resposta com a esperada
+static unsigned int TST_Reply(const char *linha, const char *esperada) {
+    const char *obtida = TST_Line(linha);
+
+    if(strcmp(obtida, esperada) == 0)
+        return 0;
+    printf("  \"%s\": \"%s\", esperado \"%s\"\n", linha, obtida, esperada);
+    return 1;
+}
+
+// CMD_Number contra a conversão da libc em todo texto de até 4 dígitos
+static void TST_Number(void) {
+    static const char *invalidos[] = {"", "-1", "+1", "1a", "a1", " 1", "1 ", "2.5", "0x1"};
+    unsigned int falhas = 0, casos = 0, v, largura, i;
+    uint8_t valor, esperado;
+    char s[8];
+
+    for(largura = 1; largura <= 4; largura++) {
+        for(v = 0; v < 10000; v++) {
+            if(largura < 4 && v >= 1000)
+                break;
+            sprintf(s, "%0*u", (int)largura, v);
+            if(strlen(s) != largura)
+                continue;
+            casos++;
+            valor = 0xA5;
+            esperado = largura <= 3 && v <= 255;
+            if(CMD_Number(s, &valor) != esperado || (esperado && valor != v) ||
+               (!esperado && valor != 0xA5)) {
+                if(falhas++ < 5)
+                    printf("  CMD_Number(\"%s\") = %u\n", s, valor);
+            }
+        }
+    }
+
+    for(i = 0; i < sizeof(invalidos) / sizeof(invalidos[0]); i++) {
+        casos++;
+        strcpy(s, invalidos[i]);
+        if(CMD_Number(s, &valor))
+            falhas++;
+    }
+
+    TST_Fim("CMD_Number", casos, falhas);
+}
+
+// CMD_Code: oversampling 0,1,2,4,8,16 e filtro 0,2,4,8,16
+static void TST_Code(void) {
+    static const uint8_t osrs[] = {0, 1, 2, 4, 8, 16};
+    static const uint8_t filtro[] = {0, 2, 4, 8, 16};
+    unsigned int falhas = 0, v, c;
+    uint8_t codigo, achou, esperado, esperado_codigo;
+
+    for(v = 0; v < 256; v++) {
+        esperado = 0;
+        esperado_codigo = 0;
+        for(c = 0; c < 6; c++)
+            if(osrs[c] == v) {
+                esperado = 1;
+                esperado_codigo = (uint8_t)c;
+            }
+        codigo = 0xA5;
+        achou = CMD_Code((uint8_t)v, 0, 6, &codigo);
+        if(achou != esperado || codigo != (esperado ? esperado_codigo : 0xA5))
+            falhas++;
+
+        esperado = 0;
+        for(c = 0; c < 5; c++)
+            if(filtro[c] == v) {
+                esperado = 1;
+                esperado_codigo = (uint8_t)c;
+            }
+        codigo = 0xA5;
+        achou = CMD_Code((uint8_t)v, 1, 5, &codigo);
+        if(achou != esperado || codigo != (esperado ? esperado_codigo : 0xA5))
+            falhas++;
+    }
+
+    TST_Fim("CMD_Code", 2 * 256, falhas);
+}
+
+// Recepção: terminadores, linhas vazias, WUE, sobrecarga e linha longa
+static void TST_Isr(void) {
+    unsigned int falhas = 0, casos = 0;
+    char longa[80];
+
+    TST_Defaults();
+    CMD_Init();
+
+    casos++; falhas += TST_Reply("GET\r", "T=1 H=1 P=1 F=0 N=A UT=0 UP=0 UU=0 L=30\r\n");
+    casos++; falhas += TST_Reply("get\n", "T=1 H=1 P=1 F=0 N=A UT=0 UP=0 UU=0 L=30\r\n");
+    casos++; falhas += TST_Reply("\r\n\r\n", "");                              // Linhas vazias
+    casos++; falhas += TST_Reply("FOO\r", "ERR\r\n");
+    casos++; falhas += TST_Reply("SAVE", "");                                  // Sem terminador
+    casos++; falhas += TST_Reply("\r", "OK\r\n");
+    casos++; falhas += TST_Reply("\r\nSAVE\r\n", "OK\r\n");                    // O LF chega com a linha pendente
+    casos++; falhas += TST_Reply("", "");                                      // e não vira linha vazia depois
+
+    // Byte 0 do WUE no meio da linha é descartado
+    casos++;
+    TST_Receive("SA\0VE\r", 6);
+    tst_tam = 0;
+    CMD_Task();
+    if(strcmp(tst_saida, "OK\r\n"))
+        falhas++;
+
+    // Sobrecarga: o byte é lido e a recepção reiniciada (CREN 0 e 1)
+    casos++;
+    OERR_bit = 1;
+    CREN_bit = 0;
+    TST_Receive("x", 1);
+    OERR_bit = 0;
+    if(!CREN_bit)
+        falhas++;
+    casos++; falhas += TST_Reply("\r", "ERR\r\n");                             // O "x" continua na linha
+
+    // Linha com CMD_TAM_LINHA caracteres é aceita; com uma a mais, ERR
+    memset(longa, ' ', sizeof(longa));
+    memcpy(longa, "GET", 3);
+    strcpy(longa + CMD_TAM_LINHA, "\r");
+    casos++; falhas += TST_Reply(longa, "T=1 H=1 P=1 F=0 N=A UT=0 UP=0 UU=0 L=30\r\n");
+    memset(longa, ' ', sizeof(longa));
+    memcpy(longa, "GET", 3);
+    strcpy(longa + CMD_TAM_LINHA + 1, "\r");
+    casos++; falhas += TST_Reply(longa, "ERR\r\n");
+    memset(longa, 'A', sizeof(longa));
+    strcpy(longa + sizeof(longa) - 2, "\r");
+    casos++; falhas += TST_Reply(longa, "ERR\r\n");
+    casos++; falhas += TST_Reply("SAVE\r", "OK\r\n");                          // Nada sobra da linha longa
+
+    // Bytes que chegam antes de CMD_Task tratar a linha são descartados
+    casos++;
+    tst_tam = 0;
+    TST_Receive("SET UT=1\rSET UT=2\r", 18);
+    if(!CMD_Pending())
+        falhas++;
+    CMD_Task();
+    CMD_Task();
+    if(strcmp(tst_saida, "OK\r\n") || ajustes.un_temp != 1 || CMD_Pending())
+        falhas++;
+
+    TST_Fim("CMD_Isr", casos, falhas);
+}
+
+// Linha de SET, resposta e efeito esperados (-1 = ajuste não muda)
+typedef struct {
+    const char *linha;
+    uint8_t vario;                                                              // Variômetro ativo
+    uint8_t ok;
+    int campo;                                                                  // Índice em ajustes_cfg
+    int valor;
+} tst_set;
+
+#define TST_T             0
+#define TST_H             1
+#define TST_P             2
+#define TST_F             3
+#define TST_UT            4
+#define TST_UP            5
+#define TST_UU            6
+#define TST_N             7
+#define TST_L             8
+
+static const tst_set tst_sets[] = {
+    // Oversampling: fator e código
+    {"SET T=0",     0, 1, TST_T, 0},  {"SET T=1",     0, 1, TST_T, 1},
+    {"SET T=2",     0, 1, TST_T, 2},  {"SET T=4",     0, 1, TST_T, 3},
+    {"SET T=8",     0, 1, TST_T, 4},  {"SET T=16",    0, 1, TST_T, 5},
+    {"SET H=16",    0, 1, TST_H, 5},  {"SET P=8",     0, 1, TST_P, 4},
+    {"SET T=3",     0, 0, -1, 0},     {"SET T=32",    0, 0, -1, 0},
+    {"SET P=255",   0, 0, -1, 0},     {"SET H=0016",  0, 0, -1, 0},
+    // Filtro: 1 não é fator válido, 2 é o código 1
+    {"SET F=0",     0, 1, TST_F, 0},  {"SET F=2",     0, 1, TST_F, 1},
+    {"SET F=16",    0, 1, TST_F, 4},  {"SET F=1",     0, 0, -1, 0},
+    {"SET F=32",    0, 0, -1, 0},     {"SET F=3",     0, 0, -1, 0},
+    // Nível
+    {"SET N=A",     0, 1, TST_N, ADPT_AUTOMATICO},
+    {"SET N=0",     0, 1, TST_N, 0},  {"SET N=3",     0, 1, TST_N, 3},
+    {"SET N=4",     0, 0, -1, 0},     {"SET N=AA",    0, 0, -1, 0},
+    {"set n=a",     0, 1, TST_N, ADPT_AUTOMATICO},
+    // Unidades e backlight
+    {"SET UT=2",    0, 1, TST_UT, 2}, {"SET UT=3",    0, 0, -1, 0},
+    {"SET UP=2",    0, 1, TST_UP, 2}, {"SET UP=3",    0, 0, -1, 0},
+    {"SET UU=1",    0, 1, TST_UU, 1}, {"SET UU=2",    0, 0, -1, 0},
+    {"SET L=0",     0, 1, TST_L, 0},  {"SET L=255",   0, 1, TST_L, 255},
+    {"SET L=007",   0, 1, TST_L, 7},  {"SET L=256",   0, 0, -1, 0},
+    {"SET L=0030",  0, 0, -1, 0},     {"SET L=1000",  0, 0, -1, 0},
+    {"SET L=",      0, 0, -1, 0},     {"SET L=-1",    0, 0, -1, 0},
+    // Sem '=', chave vazia ou desconhecida
+    {"SET",         0, 0, -1, 0},     {"SET T",       0, 0, -1, 0},
+    {"SET T 1",     0, 0, -1, 0},     {"SET =1",      0, 0, -1, 0},
+    {"SET X=1",     0, 0, -1, 0},     {"SET TT=1",    0, 0, -1, 0},
+    {"SET T==1",    0, 0, -1, 0},
+    // Com o variômetro ativo o sensor fica como está; unidades mudam
+    {"SET T=2",     1, 0, -1, 0},     {"SET F=4",     1, 0, -1, 0},
+    {"SET N=0",     1, 0, -1, 0},     {"SET UT=1",    1, 1, TST_UT, 1},
+    {"SET L=10",    1, 1, TST_L, 10},
+};
+
+// Ajuste indexado (ordem de ajustes_cfg)
+static uint8_t TST_Field(int campo) {
+    uint8_t *a = (uint8_t *)&ajustes;
+
+    return a[campo];
+}
+
+// Tabela de SET: resposta, campo alterado e sensor reconfigurado
+static void TST_Set(void) {
+    unsigned int falhas = 0, i, n, configura, tranca;
+    const tst_set *c;
+    ajustes_cfg antes;
+    char linha[32];
+    int campo;
+    uint8_t ruim;
+
+    n = sizeof(tst_sets) / sizeof(tst_sets[0]);
+    for(i = 0; i < n; i++) {
+        c = &tst_sets[i];
+        TST_Defaults();
+        ajustes.osrs_t = ajustes.osrs_h = ajustes.osrs_p = 2;                  // Diferente de todo valor pedido
+        ajustes.filtro = 2;
+        ajustes.un_temp = ajustes.un_pres = 1;
+        ajustes.nivel = 1;
+        ajustes.luz = 99;
+        tst_vario = c->vario;
+        antes = ajustes;
+        configura = tst_configura;
+        tranca = tst_tranca;
+
+        sprintf(linha, "%s\r", c->linha);
+        ruim = strcmp(TST_Line(linha), c->ok ? "OK\r\n" : "ERR\r\n") != 0;
+
+        for(campo = 0; campo < (int)sizeof(ajustes); campo++) {
+            if(campo == c->campo && c->ok) {
+                if(TST_Field(campo) != c->valor)
+                    ruim = 1;
+            } else if(TST_Field(campo) != ((uint8_t *)&antes)[campo]) {
+                ruim = 1;
+            }
+        }
+
+        // Oversampling e filtro vão ao sensor, nível a ADPT_Lock
+        if(c->ok && c->campo <= TST_F) {
+            if(tst_configura != configura + 1 || BME280_cfg.T_sampling != ajustes.osrs_t ||
+               BME280_cfg.H_sampling != ajustes.osrs_h || BME280_cfg.P_sampling != ajustes.osrs_p ||
+               BME280_cfg.filter != ajustes.filtro)
+                ruim = 1;
+        } else if(tst_configura != configura) {
+            ruim = 1;
+        }
+        if(c->ok && c->campo == TST_N) {
+            if(tst_tranca != tranca + 1 || tst_nivel != c->valor)
+                ruim = 1;
+        } else if(tst_tranca != tranca) {
+            ruim = 1;
+        }
+
+        if(ruim) {
+            printf("  \"%s\": %s", c->linha, tst_saida);
+            falhas++;
+        }
+    }
+
+    // LOAD e TUNE também são recusados com o variômetro ativo
+    TST_Defaults();
+    tst_vario = 1;
+    n += 2;
+    falhas += TST_Reply("LOAD\r", "ERR\r\n");
+    falhas += TST_Reply("TUNE\r", "ERR\r\n");
+    if(tst_carrega)
+        falhas++;
+
+    TST_Fim("CMD_Set", n, falhas);
+}
+
+int main(void) {
+    TST_Number();
+    TST_Code();
+    TST_Isr();
+    TST_Set();
+
+    printf(tst_erros ? "FALHOU: %u testes\n" : "OK\n", tst_erros);
+    return tst_erros != 0;
+}
@@ -0,0 +1,42 @@
+/******************************************************************************
+ * Arquivo: Configuração do projeto (config.h)
+ * Autor: Elison Nogueira
+ * Data: 18/10/2026
+ * Versão: 1.0
+ * Plataforma: PIC18F25K50 (Microchip)
+ * Compilador: mikroC Pro for PIC v7.6.0
+ *
+ * Descrição:
+ * Chaves de compilação que habilitam ou removem subsistemas do firmware.
+ * Altere os valores abaixo e recompile o projeto (Ctrl+F9).
+ *****************************************************************************/
+
+#ifndef CONFIG_H
+#define CONFIG_H
+
+// Display LCD, botões e variômetro. Com 0 (unidade sem display, que só registra
+// ou transmite) o LCD, o quadro, as páginas e o sprintf saem do firmware; a RAM
+// liberada vai para o histórico e as mensagens de partida vão para a serial
+#define USE_DISPLAY   1                                                         // 1 = LCD e botões, 0 = perfil sem display (headless)
+
+// Multiplicações da compensação do BME280 com os produtos 8x8 do hardware
+// (mult.h). Com 0 voltam às rotinas 32x32 do compilador, para comparar no PERF
+#define USE_MUL_8X8   1                                                         // 1 = rotinas 32x16/16x16, 0 = long * long genérico
+
+// Compensação em tempo constante para malhas de controle: o estágio
+// COMPENSACAO (pipeline.h) espera no Timer0 até o orçamento que o comando
+// WCET mede e guarda nos ajustes (SAVE grava); sem orçamento medido não há
+// espera. Só esse estágio é nivelado: leitura repetida (a cadeia para antes
+// dele), os outros estágios e a compensação do variômetro a 16Hz (vario.h)
+// continuam variando. Com 0 cada amostra leva só o que precisa
+#define USE_CONST_TIME 0                                                        // 1 = tempo constante, 0 = caminho rápido
+
+// Comando WCET: varredura de bancada do pior caso de tempo da compensação
+// (wcet.h). Bloqueia o laço por alguns segundos; deixe 0 nas unidades em campo
+#define USE_WCET      0                                                         // 1 = comando WCET, 0 = sem varredura
+
+// Dispositivo USB HID de sensores ambientais
+// Requer CONFIG1L = 0x13 (PLL 3x, CPUDIV /3): USB a 48MHz e CPU mantida em 16MHz
+#define USE_USB_HID   0                                                         // 1 = enumera como sensor HID, 0 = sem USB
+
+#endif
@@ -0,0 +1,35 @@
+/******************************************************************************
+ * Biblioteca: Histórico de amostras (historico.c)
+ * Autor: Elison Nogueira
+ * Data: 18/10/2026
+ * Versão: 1.0
+ * Plataforma: PIC18F25K50 (Microchip)
+ * Compilador: mikroC Pro for PIC v7.6.0
+ *
+ * Descrição:
+ * Buffer circular com as últimas amostras compensadas do BME280.
+ ******************************************************************************/
+
+#include "historico.h"
+
+amostra_bme280 hist_buffer[HIST_TAMANHO];                                       // Amostras armazenadas
+unsigned char hist_topo;                                                        // Próxima posição de escrita
+unsigned char hist_total;                                                       // Amostras válidas
+
+// Acrescenta uma amostra, sobrescrevendo a mais antiga quando cheio
+void HIST_Add(amostra_bme280 *a) {
+    hist_buffer[hist_topo] = *a;
+    hist_topo = (hist_topo + 1) & (HIST_TAMANHO - 1);                           // Índice circular sem divisão
+    if(hist_total < HIST_TAMANHO)
+        hist_total++;
+}
+
+// Retorna o número de amostras válidas
+unsigned char HIST_Count(void) {
+    return hist_total;
+}
+
+// Retorna a amostra com a idade pedida (0 = mais recente)
+amostra_bme280 *HIST_Get(unsigned char idade) {
+    return &hist_buffer[(hist_topo - 1 - idade) & (HIST_TAMANHO - 1)];
+}
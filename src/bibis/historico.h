@@ -0,0 +1,43 @@
+/******************************************************************************
+ * Biblioteca: Histórico de amostras (historico.h)
+ * Autor: Elison Nogueira
+ * Data: 18/10/2026
+ * Versão: 1.0
+ * Plataforma: PIC18F25K50 (Microchip)
+ * Compilador: mikroC Pro for PIC v7.6.0
+ *
+ * Descrição:
+ * Buffer circular com as últimas amostras compensadas do BME280. Cada
+ * amostra carrega o timestamp do RTC (1/4096 s) do momento da leitura, o
+ * que permite correlacionar o histórico com logs e telemetria. O comando
+ * HIST da serial (cmd.h) descarrega o buffer, da amostra mais antiga para
+ * a mais recente.
+ *****************************************************************************/
+
+#ifndef HISTORICO_H
+#define HISTORICO_H
+
+#include "config.h"
+
+// Amostras guardadas (potência de 2). Sem display o histórico é o produto da
+// unidade e fica com a RAM do quadro e das páginas (16 bytes por amostra)
+#if USE_DISPLAY
+#define HIST_TAMANHO      16
+#else
+#define HIST_TAMANHO      32
+#endif
+
+// Estrutura de uma amostra com timestamp
+typedef struct {
+    unsigned long ts;                                                           // Timestamp RTC (1/4096 s)
+    long temperatura;                                                           // Centésimos de °C
+    unsigned long umidade;                                                      // Passos de 1/1024 %
+    unsigned long pressao;                                                      // Pa
+} amostra_bme280;
+
+// Protótipos das funções
+void HIST_Add(amostra_bme280 *a);                                               // Acrescenta amostra (sobrescreve a mais antiga)
+unsigned char HIST_Count(void);                                                 // Número de amostras válidas
+amostra_bme280 *HIST_Get(unsigned char idade);                                  // 0 = mais recente
+
+#endif
@@ -0,0 +1,479 @@
+/******************************************************************************
+ * Biblioteca: Interface de páginas com botões (interface.c)
+ * Autor: Elison Nogueira
+ * Data: 18/10/2026
+ * Versão: 1.0
+ * Plataforma: PIC18F25K50 (Microchip)
+ * Compilador: mikroC Pro for PIC v7.6.0
+ *
+ * Descrição:
+ * Botões com debounce por interrupção e desenho das páginas no
+ * framebuffer. Veja interface.h.
+ ******************************************************************************/
+
+#include "config.h"
+#include "interface.h"
+#include "lcd_fb.h"
+#include "bme280.h"
+#include "previsao.h"
+#include "saude.h"
+#include "adaptativo.h"
+#include "unidades.h"
+#include "vario.h"
+#include "lcd_i2c.h"
+#include "alarme.h"
+#include "ajustes.h"
+#include "rtc.h"
+
+#if USE_DISPLAY
+
+volatile unsigned char ui_eventos;                                              // Toques confirmados ainda não tratados
+volatile unsigned char ui_pressionados;                                         // Estado estável dos botões
+volatile unsigned char ui_debounce;                                             // Estouros do Timer2 restantes
+
+ui_pagina ui_atual;                                                             // Página exibida
+unsigned char ui_lcd_pendente;                                                  // 1 = FB_Task ainda tem caracteres a enviar
+unsigned char ui_sujo;                                                          // 1 = página precisa ser redesenhada
+unsigned char ui_canal;                                                         // Canal da página Mín/Máx
+unsigned char ui_falha;                                                         // Contador da página Diagnóstico
+unsigned char ui_tem_dados;                                                     // 1 = já há amostra válida
+long ui_min[3], ui_max[3];                                                      // Extremos de T, U e P (unidade atual)
+long ui_t;                                                                      // Última amostra válida (unidade atual)
+unsigned long ui_h, ui_p;
+amostra_bme280 ui_ultima;                                                       // Última amostra válida (original)
+char ui_texto[17];                                                              // Buffer de formatação
+unsigned long ui_luz_ts;                                                        // Última atividade (botão ou alarme)
+
+// Formata um valor do canal c (0 = T, 1 = U, 2 = P) já convertido
+static unsigned char UI_FmtCanal(char *s, unsigned char c, long v) {
+    switch(c) {
+        case 0:  return UN_FmtTemp(s, v);
+        case 1:  return UN_FmtUmid(s, (unsigned long)v);
+        default: return UN_FmtPres(s, (unsigned long)v);
+    }
+}
+
+// Escreve em s o nome de um tipo de falha do monitor de saúde; retorna o tamanho
+static unsigned char UI_FalhaNome(char *s, unsigned char f) {
+    s[0] = 0;
+    switch(f) {
+        case HLTH_ID:      return UN_Cat(s, "ID chip");
+        case HLTH_PULADO:  return UN_Cat(s, "Pulado");
+        case HLTH_TRAVADO: return UN_Cat(s, "Travado");
+        case HLTH_FAIXA:   return UN_Cat(s, "Faixa");
+        default:           return UN_Cat(s, "Degrau");
+    }
+}
+
+// Página Valores: T, U, P e ícone da previsão
+static void UI_DrawValores(void) {
+    unsigned char i, n, col;
+    unsigned int total;
+
+    if(HLTH_Status()) {                                                         // Não exibe valores congelados
+        total = 0;
+        for(i = 0; i < HLTH_QTD; i++)
+            total += HLTH_Count(i);
+        FB_Out(1, 1, "Falha sensor!");
+        ui_texto[0] = 0;
+        n = UN_Cat(ui_texto, "Cod ");
+        n += UN_FmtHex(ui_texto + n, HLTH_Status());
+        n = UN_Cat(ui_texto, " Tot ");
+        UN_FmtUInt(ui_texto + n, total);
+        col = FB_Marquee(1, ui_texto);
+        for(i = 0; i < HLTH_QTD; i++)                                           // Descrição rola na faixa
+            if(HLTH_Status() & (1 << i)) {
+                UI_FalhaNome(ui_texto, i);
+                col = FB_Marquee(col + 1, ui_texto);
+            }
+        return;
+    }
+
+    if(!ui_tem_dados) {
+        FB_Out(1, 1, "Aguardando...");
+        return;
+    }
+
+    UN_FmtTemp(ui_texto, ui_t);
+    FB_Out(1, 1, ui_texto);
+    n = UN_FmtUmid(ui_texto, ui_h);
+    FB_Out(1, 17 - n, ui_texto);                                                // Alinhada à direita
+    UN_FmtPres(ui_texto, ui_p);
+    FB_Out(2, 1, ui_texto);
+    FB_Chr(2, 16, PREV_Icon());
+}
+
+// Página Mín/Máx do canal selecionado
+static void UI_DrawMinMax(void) {
+    char *nome;
+
+    switch(ui_canal) {
+        case 0:  nome = "T";  break;
+        case 1:  nome = "U";  break;
+        default: nome = "P";  break;
+    }
+    FB_Out(1, 1, nome);
+    FB_Out(1, 3, "min");
+    FB_Out(2, 3, "max");
+
+    if(!ui_tem_dados)
+        return;
+
+    UI_FmtCanal(ui_texto, ui_canal, ui_min[ui_canal]);
+    FB_Out(1, 7, ui_texto);
+    UI_FmtCanal(ui_texto, ui_canal, ui_max[ui_canal]);
+    FB_Out(2, 7, ui_texto);
+}
+
+// Página Tendência: código de Zambretti, seta e variação em 3 horas, com a
+// tendência e o tempo previsto por extenso rolando na linha 2
+static void UI_DrawTendencia(void) {
+    long delta;
+    unsigned char seta, n, col;
+    const char *tendencia, *tempo;
+
+    FB_Out(1, 1, "Previsao:");
+    FB_Chr(1, 11, PREV_Code());
+    FB_Chr(1, 13, PREV_Icon());
+
+    if(PREV_Trend() == PREV_SEM_DADOS) {
+        FB_Out(2, 1, "Aguardando 3h");
+        return;
+    }
+
+    switch(PREV_Trend()) {
+        case PREV_SUBINDO: seta = PREV_ICONE_SOBE;    tendencia = "subindo,"; break;
+        case PREV_CAINDO:  seta = PREV_ICONE_DESCE;   tendencia = "caindo,";  break;
+        default:           seta = PREV_ICONE_ESTAVEL; tendencia = "estavel,"; break;
+    }
+    switch(PREV_Icon()) {
+        case PREV_ICONE_SOL:       tempo = "tempo bom"; break;
+        case PREV_ICONE_NUVEM_SOL: tempo = "variavel";  break;
+        case PREV_ICONE_NUVEM:     tempo = "instavel";  break;
+        default:                   tempo = "chuva";     break;
+    }
+    FB_Chr(2, 1, seta);
+
+    delta = PREV_Delta();
+    if(delta < 0) {
+        ui_texto[0] = '-';
+        n = 1 + UN_FmtPres(ui_texto + 1, UN_Pres(-delta));
+    } else {
+        ui_texto[0] = '+';
+        n = 1 + UN_FmtPres(ui_texto + 1, UN_Pres(delta));
+    }
+    UN_Cat(ui_texto + n, "/3h");
+    col = FB_Marquee(3, ui_texto);
+    ui_texto[0] = 0;
+    UN_Cat(ui_texto, tendencia);
+    col = FB_Marquee(col + 1, ui_texto);
+    ui_texto[0] = 0;
+    UN_Cat(ui_texto, tempo);
+    FB_Marquee(col + 1, ui_texto);
+}
+
+// Página Diagnóstico: estado atual e um contador de falhas por vez
+static void UI_DrawDiagnostico(void) {
+    unsigned char n;
+
+    FB_Out(1, 1, "Diag estado");
+    UN_FmtHex(ui_texto, HLTH_Status());
+    FB_Out(1, 13, ui_texto);
+
+    n = UI_FalhaNome(ui_texto, ui_falha);
+    ui_texto[n++] = ' ';
+    UN_FmtUInt(ui_texto + n, HLTH_Count(ui_falha));
+    FB_Out(2, 1, ui_texto);
+}
+
+// Página Unidades: unidades atuais (a ação avança como um odômetro: T, P, U)
+static void UI_DrawUnidades(void) {
+    FB_Out(1, 1, "T:");
+    switch(un_temp) {
+        case UN_FAHRENHEIT: FB_Out(1, 3, "F");    break;
+        case UN_KELVIN:     FB_Out(1, 3, "K");    break;
+        default:            FB_Out(1, 3, "C");    break;
+    }
+
+    FB_Out(1, 7, "P:");
+    switch(un_pres) {
+        case UN_INHG:       FB_Out(1, 9, "inHg"); break;
+        case UN_MMHG:       FB_Out(1, 9, "mmHg"); break;
+        default:            FB_Out(1, 9, "hPa");  break;
+    }
+
+    FB_Out(2, 1, "U:");
+    if(un_umid == UN_ABSOLUTA)
+        FB_Out(2, 3, "g/m3");
+    else
+        FB_Out(2, 3, "% UR");
+}
+
+// Página Ajustes: oversampling (x), coeficiente do filtro e nível adaptativo
+static void UI_DrawAjustes(void) {
+    unsigned char n;
+
+    n = 0;
+    ui_texto[n++] = 'T';
+    n += UN_FmtUInt(ui_texto + n, BME280_cfg.T_sampling ? 1 << (BME280_cfg.T_sampling - 1) : 0);
+    ui_texto[n++] = ' ';
+    ui_texto[n++] = 'H';
+    n += UN_FmtUInt(ui_texto + n, BME280_cfg.H_sampling ? 1 << (BME280_cfg.H_sampling - 1) : 0);
+    ui_texto[n++] = ' ';
+    ui_texto[n++] = 'P';
+    n += UN_FmtUInt(ui_texto + n, BME280_cfg.P_sampling ? 1 << (BME280_cfg.P_sampling - 1) : 0);
+    ui_texto[n++] = ' ';
+    ui_texto[n++] = 'F';
+    UN_FmtUInt(ui_texto + n, BME280_cfg.filter ? 1 << BME280_cfg.filter : 0);
+    FB_Out(1, 1, ui_texto);
+
+    FB_Out(2, 1, "Nivel");
+    ui_texto[0] = '0' + ADPT_Level();
+    ui_texto[1] = 0;
+    FB_Out(2, 7, ui_texto);
+    FB_Out(2, 9, ">Ajuste");
+}
+
+// Página Variômetro: velocidade vertical (m/s) e altitude padrão (m)
+static void UI_DrawVario(void) {
+    long taxa;
+    unsigned char n;
+
+    FB_Out(1, 1, "Vario");
+    FB_Out(2, 1, "Alt");
+
+    if(!VAR_Active())
+        return;
+
+    taxa = VAR_Rate();                                                          // cm/s = centésimos de m/s
+    n = 0;
+    if(taxa >= 0)
+        ui_texto[n++] = '+';
+    n += UN_FmtDec(ui_texto + n, taxa, 2);
+    UN_Cat(ui_texto + n, "m/s");
+    FB_Out(1, 7, ui_texto);
+
+    n = UN_FmtDec(ui_texto, VAR_Altitude(), 1);
+    UN_Cat(ui_texto + n, "m");
+    FB_Out(2, 5, ui_texto);
+}
+
+// Desenha a página atual no framebuffer
+static void UI_Draw(void) {
+    FB_Clear();
+
+    switch(ui_atual) {
+        case UI_VALORES:     UI_DrawValores();     break;
+        case UI_MINMAX:      UI_DrawMinMax();      break;
+        case UI_TENDENCIA:   UI_DrawTendencia();   break;
+        case UI_DIAGNOSTICO: UI_DrawDiagnostico(); break;
+        case UI_UNIDADES:    UI_DrawUnidades();    break;
+        case UI_VARIO:       UI_DrawVario();       break;
+        default:             UI_DrawAjustes();     break;
+    }
+}
+
+// Configura botões, Timer2 de debounce e a página inicial
+void UI_Init(void) {
+    ANSELB &= ~UI_BOTOES;                                                       // Pinos digitais
+    TRISB |= UI_BOTOES;                                                         // Entradas
+    WPUB = UI_BOTOES;                                                           // Pull-ups só nos botões
+    RBPU_bit = 0;                                                               // Habilita os pull-ups de PORTB
+
+    T2CON = 0x4A;                                                               // Pós 1:10, pré 1:16, desligado
+    PR2 = 249;                                                                  // 16MHz/4/16/250/10 = 100Hz (10ms)
+    TMR2IF_bit = 0;
+    TMR2IE_bit = 1;
+
+    ui_eventos = 0;
+    ui_debounce = 0;
+    ui_pressionados = ~PORTB & UI_BOTOES;                                       // Leitura também zera o mismatch
+    IOCB |= UI_BOTOES;
+    IOCIF_bit = 0;
+    IOCIE_bit = 1;
+    PEIE_bit = 1;
+    GIE_bit = 1;
+
+    ui_atual = UI_VALORES;
+    ui_canal = 0;
+    ui_falha = 0;
+    ui_tem_dados = 0;
+    ui_lcd_pendente = 0;
+    ui_sujo = 1;
+    ui_luz_ts = RTC_Now();                                                      // O LCD parte com o backlight aceso
+
+    FB_Invalidate();
+}
+
+// Trata a mudança de estado dos botões e o fim do debounce
+void UI_Isr(void) {
+    unsigned char estavel;
+
+    if(IOCIF_bit && IOCIE_bit) {
+        estavel = PORTB;                                                        // Encerra o mismatch antes de limpar o flag
+        IOCIF_bit = 0;
+        IOCIE_bit = 0;                                                          // Ignora os repiques até o fim do debounce
+        ui_debounce = UI_DEBOUNCE;
+        TMR2 = 0;
+        TMR2IF_bit = 0;
+        TMR2ON_bit = 1;
+    }
+
+    if(TMR2IF_bit && TMR2IE_bit) {
+        TMR2IF_bit = 0;
+        if(--ui_debounce == 0) {
+            TMR2ON_bit = 0;
+            estavel = ~PORTB & UI_BOTOES;                                       // Ativos em nível baixo
+            ui_eventos |= estavel & ~ui_pressionados;                           // Só o aperto gera evento
+            ui_pressionados = estavel;
+            IOCIF_bit = 0;
+            IOCIE_bit = 1;
+        }
+    }
+}
+
+// Converte a última amostra para as unidades atuais; reinicia os extremos se pedido
+static void UI_Convert(unsigned char reinicia) {
+    long v[3];
+    unsigned char c;
+
+    v[0] = UN_Temp(ui_ultima.temperatura);                                      // Conversão feita uma vez por amostra
+    v[1] = (long)UN_Umid(ui_ultima.temperatura, ui_ultima.umidade);
+    v[2] = (long)UN_Pres(ui_ultima.pressao);
+
+    for(c = 0; c < 3; c++) {
+        if(reinicia || v[c] < ui_min[c]) ui_min[c] = v[c];
+        if(reinicia || v[c] > ui_max[c]) ui_max[c] = v[c];
+    }
+
+    ui_t = v[0];
+    ui_h = (unsigned long)v[1];
+    ui_p = (unsigned long)v[2];
+}
+
+// Registra uma amostra válida: atualiza os extremos e pede redesenho
+void UI_Sample(amostra_bme280 *a) {
+    ui_ultima = *a;
+    UI_Convert(!ui_tem_dados);
+    ui_tem_dados = 1;
+    ui_sujo = 1;
+}
+
+// Pede o redesenho da página atual
+void UI_Refresh(void) {
+    ui_sujo = 1;
+}
+
+// Retorna a página exibida
+ui_pagina UI_Page(void) {
+    return ui_atual;
+}
+
+// Reconverte a última amostra após a troca de unidades (zera os extremos)
+void UI_UnitsChanged(void) {
+    if(ui_tem_dados)
+        UI_Convert(1);                                                          // Extremos guardados estavam na unidade antiga
+    ui_sujo = 1;
+}
+
+// Avança as unidades como um odômetro (T, depois P, depois U) e zera os extremos
+static void UI_NextUnit(void) {
+    unsigned char t, p, u;
+
+    t = un_temp + 1;
+    p = un_pres;
+    u = un_umid;
+    if(t == UN_T_QTD) {
+        t = 0;
+        if(++p == UN_P_QTD) {
+            p = 0;
+            if(++u == UN_H_QTD)
+                u = 0;
+        }
+    }
+    UN_Select(t, p, u);
+    UI_UnitsChanged();
+}
+
+// Backlight: botão ou alarme acende e renova a contagem; ajustes.luz segundos
+// sem atividade apagam. Retorna os eventos que restam para as páginas
+static unsigned char UI_Light(unsigned char eventos) {
+    if(eventos || ALM_Status() || !ajustes.luz) {
+        ui_luz_ts = RTC_Now();
+        if(!I2C_LCD_Backlight_On()) {
+            I2C_LCD_Backlight(1);
+            return 0;                                                           // Toque com a luz apagada só acende
+        }
+    } else if(I2C_LCD_Backlight_On() && RTC_Now() - ui_luz_ts >= (unsigned long)ajustes.luz * RTC_HZ) {
+        I2C_LCD_Backlight(0);
+    }
+
+    return eventos;
+}
+
+// Trata os botões, redesenha se necessário e envia diferenças ao LCD
+unsigned char UI_Task(void) {
+    unsigned char eventos, gie, pedido;
+
+    gie = INTCON & 0x80;                                                        // Lê e zera os eventos sem corrida com a ISR
+    GIE_bit = 0;
+    eventos = ui_eventos;
+    ui_eventos = 0;
+    if(gie) GIE_bit = 1;
+
+    eventos = UI_Light(eventos);
+    pedido = UI_NADA;
+
+    if(eventos & UI_BTN_PROXIMA) {
+        ui_atual = (ui_atual + 1) % UI_PAGINAS;
+        ui_sujo = 1;
+    }
+
+    if(eventos & UI_BTN_ACAO) {
+        switch(ui_atual) {
+            case UI_MINMAX:      ui_canal = (ui_canal + 1) % 3;        break;
+            case UI_DIAGNOSTICO: ui_falha = (ui_falha + 1) % HLTH_QTD; break;
+            case UI_UNIDADES:    UI_NextUnit();
+                                 pedido = UI_PEDE_GRAVAR;              break;
+            case UI_AJUSTES:     pedido = UI_PEDE_AJUSTE;              break;
+            default:                                                   break;
+        }
+        ui_sujo = 1;
+    }
+
+    if(ui_sujo) {
+        ui_sujo = 0;
+        UI_Draw();
+    }
+
+    ui_lcd_pendente = FB_Task();
+
+    return pedido;
+}
+
+// Próximo instante em que a interface precisa acordar: passo do quadro ou
+// apagamento do backlight, o que vier antes do prazo recebido
+unsigned long UI_Deadline(unsigned long prazo) {
+    unsigned long apaga;
+
+    prazo = FB_Deadline(prazo);
+    if(ajustes.luz && I2C_LCD_Backlight_On()) {
+        apaga = ui_luz_ts + (unsigned long)ajustes.luz * RTC_HZ;
+        if((long)(apaga - prazo) < 0)
+            prazo = apaga;
+    }
+
+    return prazo;
+}
+
+// Retorna 1 se a interface ainda tem trabalho (o laço não deve dormir)
+unsigned char UI_Pending(void) {
+    return ui_eventos || ui_sujo || ui_lcd_pendente;
+}
+
+// Retorna 1 durante o debounce (o Timer2 para em SLEEP)
+unsigned char UI_Debouncing(void) {
+    return ui_debounce != 0;
+}
+
+#endif
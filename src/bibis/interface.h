@@ -0,0 +1,105 @@
+/******************************************************************************
+ * Biblioteca: Interface de páginas com botões (interface.h)
+ * Autor: Elison Nogueira
+ * Data: 18/10/2026
+ * Versão: 1.0
+ * Plataforma: PIC18F25K50 (Microchip)
+ * Compilador: mikroC Pro for PIC v7.6.0
+ *
+ * Descrição:
+ * Sistema de páginas do display controlado por dois botões:
+ * - RB4 (Próxima): avança para a próxima página
+ * - RB5 (Ação): ação da página atual
+ *
+ *   Página        Conteúdo                             Ação
+ *   Valores       T, UR, P e ícone da previsão         -
+ *   Mín/Máx       Extremos desde a inicialização       Troca o canal (T/U/P)
+ *   Tendência     Zambretti, seta e variação em 3h     -
+ *   Diagnóstico   Estado e contadores de falha         Troca o contador
+ *   Unidades      Unidades de T, P e U                 Próxima combinação
+ *   Ajustes       Oversampling, filtro e nível         Refaz o auto-ajuste
+ *   Variômetro    Velocidade vertical e altitude       -
+ *
+ * Os botões ligam ao GND (pull-ups internos de PORTB) e usam a interrupção
+ * por mudança de estado (IOC). A primeira borda desabilita o IOC e dispara
+ * o Timer2; após UI_DEBOUNCE estouros de 10ms o pino é amostrado de novo e
+ * só então o toque é registrado. Nada disso bloqueia o laço principal.
+ *
+ * As páginas são desenhadas no framebuffer (lcd_fb.h) apenas quando algo
+ * muda, e o envio ao LCD é feito em pedaços por FB_Task. Os valores são
+ * convertidos para as unidades escolhidas (unidades.h) uma vez por amostra
+ * e formatados sem divisão.
+ *
+ * Entrar na página Variômetro liga o modo de alta taxa (vario.h) e sair
+ * dela o desliga; o laço principal consulta UI_Page() para isso.
+ *
+ * O backlight apaga após ajustes.luz segundos sem toque (0 = sempre aceso).
+ * Com a luz apagada, o primeiro toque só a acende e não muda a página; um
+ * alarme ativo acende e mantém a luz. UI_Deadline inclui o instante do
+ * apagamento no prazo de SLEEP do laço principal.
+ *
+ * No perfil sem display (USE_DISPLAY = 0) interface.c fica vazio e os avisos
+ * que outros módulos mandam à interface viram macros vazias; as chamadas
+ * estruturais (UI_Init, UI_Isr, UI_Task) são removidas no próprio main.c.
+ *
+ * Dependências:
+ * - Timer2 (debounce) e IOC de RB4/RB5
+ *****************************************************************************/
+
+#ifndef INTERFACE_H
+#define INTERFACE_H
+
+#include "config.h"
+#include "historico.h"
+
+// Botões em PORTB (ativos em nível baixo)
+#define UI_BTN_PROXIMA    0x10                                                  // RB4
+#define UI_BTN_ACAO       0x20                                                  // RB5
+#define UI_BOTOES         (UI_BTN_PROXIMA | UI_BTN_ACAO)
+
+#define UI_DEBOUNCE       2                                                     // Estouros de 10ms do Timer2 (20ms)
+
+// Páginas
+typedef enum {
+    UI_VALORES     = 0,
+    UI_MINMAX      = 1,
+    UI_TENDENCIA   = 2,
+    UI_DIAGNOSTICO = 3,
+    UI_UNIDADES    = 4,
+    UI_AJUSTES     = 5,
+    UI_VARIO       = 6,
+    UI_PAGINAS     = 7                                                          // Número de páginas
+} ui_pagina;
+
+// Pedidos da interface ao laço principal (retorno de UI_Task)
+#define UI_NADA           0
+#define UI_PEDE_AJUSTE    1                                                     // Refazer o auto-ajuste
+#define UI_PEDE_GRAVAR    2                                                     // Gravar as unidades na EEPROM
+
+#if USE_DISPLAY
+
+// Protótipos das funções
+void UI_Init(void);                                                             // Configura botões, Timer2 e a primeira página
+void UI_Isr(void);                                                              // Trata IOC e Timer2 (chamar na interrupção)
+void UI_Sample(amostra_bme280 *a);                                              // Nova amostra (mín/máx e redesenho)
+void UI_Refresh(void);                                                          // Redesenha a página atual
+ui_pagina UI_Page(void);                                                        // Página exibida
+unsigned char UI_Pending(void);                                                 // 1 = há botão, redesenho ou envio ao LCD pendente
+unsigned char UI_Debouncing(void);                                              // 1 = debounce em andamento (Timer2 precisa de clock)
+void UI_UnitsChanged(void);                                                     // Unidades trocadas fora da interface
+unsigned char UI_Task(void);                                                    // Trata botões e desenha; retorna um pedido
+unsigned long UI_Deadline(unsigned long prazo);                                 // Antecipa o prazo para o quadro e o backlight
+
+#else
+
+// Sem display: avisos à interface não fazem nada e ela nunca segura o SLEEP
+#define UI_Sample(a)
+#define UI_Refresh()
+#define UI_UnitsChanged()
+#define UI_Pending()      0
+#define UI_Debouncing()   0
+#define UI_Deadline(p)    (p)
+
+#endif
+
+#endif
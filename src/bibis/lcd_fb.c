@@ -0,0 +1,165 @@
+/******************************************************************************
+ * Biblioteca: Framebuffer do LCD (lcd_fb.c)
+ * Autor: Elison Nogueira
+ * Data: 18/10/2026
+ * Versão: 1.0
+ * Plataforma: PIC18F25K50 (Microchip)
+ * Compilador: mikroC Pro for PIC v7.6.0
+ *
+ * Descrição:
+ * Quadro em RAM e envio incremental das diferenças. Veja lcd_fb.h.
+ ******************************************************************************/
+
+#include "config.h"
+#include "lcd_fb.h"
+#include "lcd_i2c.h"
+#include "rtc.h"
+
+#if USE_DISPLAY
+
+#define FB_TAM            (FB_COLUNAS + FB_DDRAM)                               // Células: linha 1 visível e linha 2 inteira
+#define FB_DESCONHECIDO   0xFF                                                  // Posição do cursor ou da janela não conhecida
+
+char fb_quadro[FB_TAM];                                                         // Conteúdo desejado
+char fb_lcd[FB_TAM];                                                            // Conteúdo atual do display
+unsigned char fb_cursor;                                                        // Célula apontada pelo cursor do LCD
+unsigned char fb_sujo;                                                          // 1 = pode haver diferenças
+unsigned char fb_faixa;                                                         // Caracteres da faixa na linha 2 (0 = sem faixa)
+unsigned char fb_desloc;                                                        // Colunas deslocadas à esquerda
+unsigned char fb_volta;                                                         // 1 = voltando para a origem
+unsigned char fb_rolando;                                                       // 1 = faixa maior que a tela
+unsigned long fb_prazo;                                                         // Instante do próximo passo
+
+// Preenche o quadro com espaços e encerra a faixa
+void FB_Clear(void) {
+    unsigned char i;
+
+    for(i = 0; i < FB_TAM; i++)
+        fb_quadro[i] = ' ';
+    fb_faixa = 0;
+    fb_sujo = 1;
+}
+
+// Escreve um caractere no quadro
+void FB_Chr(char row, char col, char out_char) {
+    if(row < 1 || row > FB_LINHAS || col < 1 || col > FB_COLUNAS)
+        return;
+
+    fb_quadro[(row - 1) * FB_COLUNAS + (col - 1)] = out_char;
+    fb_sujo = 1;
+}
+
+// Escreve uma string no quadro, cortando o que passar da borda
+void FB_Out(char row, char col, char *text) {
+    while(*text && col <= FB_COLUNAS)
+        FB_Chr(row, col++, *text++);
+}
+
+// Escreve na faixa da linha 2 (até a coluna 40); o que passar de 16 rola
+char FB_Marquee(char col, char *text) {
+    while(*text && col <= FB_DDRAM) {
+        fb_quadro[FB_COLUNAS + col - 1] = *text++;
+        col++;
+    }
+    if(col - 1 > fb_faixa)
+        fb_faixa = col - 1;
+    fb_sujo = 1;
+
+    return col;
+}
+
+// Marca todo o display como desconhecido para que seja redesenhado
+void FB_Invalidate(void) {
+    unsigned char i;
+
+    for(i = 0; i < FB_TAM; i++)
+        fb_lcd[i] = FB_DESCONHECIDO;                                            // Nenhum caractere usado é 0xFF
+    fb_cursor = FB_DESCONHECIDO;
+    fb_desloc = FB_DESCONHECIDO;                                                // Volta a janela à origem no próximo envio
+    fb_sujo = 1;
+}
+
+// Dá um passo da rolagem se estiver na hora (ida até o fim do texto e volta)
+static void FB_Scroll(void) {
+    unsigned char fim;
+
+    fim = fb_faixa > FB_COLUNAS ? fb_faixa - FB_COLUNAS : 0;                    // Deslocamento que mostra o fim do texto
+
+    if(fb_desloc == FB_DESCONHECIDO || (!fim && fb_desloc)) {
+        I2C_LCD_Cmd(_LCD_RETURN_HOME);                                          // Desfaz o deslocamento e zera o endereço
+        fb_desloc = 0;
+        fb_cursor = 0;
+        fb_volta = 0;
+        fb_rolando = 0;
+    }
+
+    if(!fim) {
+        fb_rolando = 0;
+        return;
+    }
+    if(!fb_rolando) {
+        fb_rolando = 1;
+        fb_prazo = RTC_Now() + FB_PAUSA;                                        // Começa parada na origem
+        return;
+    }
+    if((long)(RTC_Now() - fb_prazo) < 0)
+        return;
+
+    if(fb_volta || fb_desloc > fim) {                                           // O texto pode ter encurtado
+        I2C_LCD_Cmd(_LCD_SHIFT_RIGHT);
+        fb_desloc--;
+        fb_volta = fb_desloc != 0;
+        fb_prazo = RTC_Now() + (fb_volta ? FB_PASSO : FB_PAUSA);
+    } else {
+        I2C_LCD_Cmd(_LCD_SHIFT_LEFT);
+        fb_desloc++;
+        fb_volta = fb_desloc == fim;
+        fb_prazo = RTC_Now() + (fb_volta ? FB_PAUSA : FB_PASSO);
+    }
+}
+
+// Envia ao LCD até FB_LOTE caracteres diferentes; retorna 1 se ainda há pendências
+unsigned char FB_Task(void) {
+    unsigned char i, enviados;
+
+    if(fb_sujo) {
+        enviados = 0;
+        for(i = 0; i < FB_TAM; i++) {
+            if(fb_quadro[i] == fb_lcd[i])
+                continue;
+
+            if(enviados == FB_LOTE) {
+                I2C_LCD_Flush();
+                return 1;                                                       // Continua na próxima chamada
+            }
+            if(enviados == 0)
+                I2C_LCD_Begin();                                                // O lote inteiro vai numa transação
+
+            if(fb_cursor != i)                                                  // Reposiciona só fora de sequência
+                I2C_LCD_Enqueue(i < FB_COLUNAS ? _LCD_FIRST_ROW + i : _LCD_SECOND_ROW + (i - FB_COLUNAS), LCD_RS_CMD);
+
+            I2C_LCD_Enqueue(fb_quadro[i], LCD_RS_DADO);
+            fb_lcd[i] = fb_quadro[i];
+            fb_cursor = i + 1;                                                  // O LCD avança o endereço sozinho
+            if(fb_cursor == FB_COLUNAS || fb_cursor == FB_TAM)
+                fb_cursor = FB_DESCONHECIDO;                                    // Fim da linha não segue para a próxima
+            enviados++;
+        }
+        if(enviados)
+            I2C_LCD_Flush();
+        fb_sujo = 0;
+    }
+
+    FB_Scroll();                                                                // Só rola com o texto já no display
+    return 0;
+}
+
+// Retorna o menor entre prazo e o próximo passo da rolagem
+unsigned long FB_Deadline(unsigned long prazo) {
+    if(fb_rolando && (long)(fb_prazo - prazo) < 0)
+        return fb_prazo;
+
+    return prazo;
+}
+
+#endif
@@ -0,0 +1,59 @@
+/******************************************************************************
+ * Biblioteca: Framebuffer do LCD (lcd_fb.h)
+ * Autor: Elison Nogueira
+ * Data: 18/10/2026
+ * Versão: 1.0
+ * Plataforma: PIC18F25K50 (Microchip)
+ * Compilador: mikroC Pro for PIC v7.6.0
+ *
+ * Descrição:
+ * Cópia em RAM do conteúdo do LCD 16x2. As telas são desenhadas no quadro
+ * (FB_Out/FB_Chr, sem acesso ao I2C) e FB_Task envia ao display apenas os
+ * caracteres que diferem do que já está na tela, no máximo FB_LOTE por
+ * chamada. Os caracteres de uma chamada vão numa só transação I2C (lote de
+ * lcd_i2c.h): ~0.36ms por caractere a 100kHz, mais um comando de posição
+ * quando fora de sequência, logo uma chamada nunca prende o laço principal
+ * por mais de ~3ms, e uma troca de tela que muda poucos campos é enviada em
+ * poucos milissegundos.
+ *
+ * Quem escrever direto no LCD (I2C_LCD_Out) deve chamar FB_Invalidate em
+ * seguida para que o próximo envio redesenhe a tela inteira.
+ *
+ * Faixa rolante: cada linha do HD44780 tem 40 posições de DDRAM, das quais
+ * só 16 aparecem. FB_Marquee escreve até 40 caracteres na linha 2 e, se o
+ * texto passar de 16, FB_Task rola a janela com _LCD_SHIFT_LEFT e volta com
+ * _LCD_SHIFT_RIGHT, uma coluna por FB_PASSO, com FB_PAUSA nas pontas. O
+ * texto é enviado uma vez pelo mesmo mecanismo de diferenças (a linha 2 do
+ * quadro tem 40 células); cada passo custa um comando (~0.5ms) em vez de
+ * reescrever 16 caracteres (~6ms).
+ *
+ * O deslocamento do controlador move as duas linhas juntas: durante a
+ * rolagem a linha 1 sai de vista e volta inteira nas pausas com a janela na
+ * origem. As posições 16..39 da linha 1 nunca são escritas e ficam em
+ * branco. FB_Deadline informa ao laço quando é o próximo passo, para que o
+ * escalonador acorde a tempo. A sequência é conferida no host contra um
+ * modelo da DDRAM e do deslocamento em lcd_fb_teste.c (teste_host.py).
+ *****************************************************************************/
+
+#ifndef LCD_FB_H
+#define LCD_FB_H
+
+#include "rtc.h"
+
+#define FB_LINHAS         2                                                     // Linhas do display
+#define FB_COLUNAS        16                                                    // Colunas do display
+#define FB_LOTE           8                                                     // Caracteres enviados por FB_Task
+#define FB_DDRAM          40                                                    // Posições de DDRAM por linha (tamanho máximo da faixa)
+#define FB_PASSO          (RTC_HZ / 4)                                          // Intervalo entre passos da rolagem (4 colunas/s)
+#define FB_PAUSA          (2 * RTC_HZ)                                          // Parada com a faixa em cada ponta
+
+// Protótipos das funções
+void FB_Clear(void);                                                            // Preenche o quadro com espaços
+void FB_Chr(char row, char col, char out_char);                                 // Escreve um caractere (linha/coluna a partir de 1)
+void FB_Out(char row, char col, char *text);                                    // Escreve uma string (cortada na borda)
+char FB_Marquee(char col, char *text);                                          // Escreve na faixa da linha 2 (coluna 1..40); retorna a coluna seguinte
+void FB_Invalidate(void);                                                       // Força o redesenho completo
+unsigned char FB_Task(void);                                                    // Envia diferenças e rola a faixa (1 = ainda há pendências)
+unsigned long FB_Deadline(unsigned long prazo);                                 // Menor entre prazo e o próximo passo da faixa
+
+#endif
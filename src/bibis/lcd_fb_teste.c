@@ -0,0 +1,374 @@
+/******************************************************************************
+ * Teste no host: Envio de diferenças e faixa rolante (lcd_fb_teste.c)
+ * Autor: Elison Nogueira
+ * Data: 18/10/2026
+ * Versão: 1.0
+ * Plataforma: PC (gcc)
+ *
+ * Descrição:
+ * Compila o lcd_fb.c do firmware contra um modelo do HD44780 de 2 linhas
+ * no lugar do I2C: DDRAM de 40 posições por linha (0x00..0x27 e
+ * 0x40..0x67), contador de endereço que avança a cada caractere e passa do
+ * fim de uma linha para o início da outra, deslocamento da janela módulo
+ * 40 (coluna visível c mostra a posição (c + desloc) % 40 das duas
+ * linhas), RETURN_HOME que zera endereço e deslocamento e CLEAR. O RTC é
+ * simulado; FB_Task roda a cada tick ou só nos prazos de FB_Deadline.
+ *
+ *   Teste         Verifica
+ *   Quadro        Tela estática com o LCD em estado arbitrário (janela
+ *                 deslocada, endereço e DDRAM sujos): depois de
+ *                 FB_Invalidate, um só RETURN_HOME e a tela igual ao quadro
+ *   Faixa         Textos de 1 a 40 caracteres por TST_CICLOS idas e voltas,
+ *                 FB_Task a cada tick: sem rolagem até 16; acima disso
+ *                 L - 16 SHIFT_LEFT e L - 16 SHIFT_RIGHT por ciclo, passos
+ *                 a FB_PASSO e pausas de FB_PAUSA nas pontas, o fim do texto
+ *                 visível na pausa da ponta, nenhum RETURN_HOME
+ *   Prazos        Os mesmos textos chamando FB_Task só em FB_Deadline: os
+ *                 passos saem nos mesmos ticks
+ *   Troca         Texto encurtado com a janela na ponta (volta à origem e
+ *                 passa a rolar só até o novo fim), texto de até 16 com a
+ *                 janela deslocada (RETURN_HOME) e FB_Invalidate no meio da
+ *                 rolagem (RETURN_HOME e a rolagem recomeça da origem)
+ *
+ * Em toda chamada: o deslocamento do modelo é o fb_desloc do firmware, o
+ * endereço do modelo é o fb_cursor quando este é conhecido, as posições
+ * 16..39 da linha 1 continuam em branco e, com o quadro enviado, cada
+ * coluna visível mostra o quadro (linha 1 fora da origem: branco).
+ *
+ * Não compila sozinho: teste_host.py copia o lcd_fb.c com os tipos do mikroC
+ * e compila este arquivo contra ele (veja lá).
+ *
+ * Uso: python3 teste_host.py lcd_fb
+ * Sai com 1 se alguma verificação falhar.
+ *****************************************************************************/
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "lcd_fb_host.c"
+
+#define TST_CICLOS        2                                                     // Idas e voltas por texto
+#define TST_POS           40                                                    // Posições de DDRAM por linha
+
+// HD44780 simulado
+uint8_t tst_ddram[2][TST_POS];
+uint8_t tst_ac;                                                                 // Contador de endereço (linha * 40 + coluna)
+uint8_t tst_desloc;                                                             // Deslocamento da janela (0..39)
+unsigned int tst_esquerda, tst_direita, tst_inicio, tst_outros;
+unsigned int tst_transacao;                                                     // 1 = entre Begin e Flush
+
+uint32_t tst_agora;                                                             // Ticks do RTC simulado
+uint32_t tst_passos[4 * TST_POS * TST_CICLOS + 8];                              // Ticks de cada passo da rolagem
+unsigned int tst_qtd_passos;
+
+uint32_t RTC_Now(void) {
+    return tst_agora;
+}
+
+// Executa um byte no controlador
+static void TST_Execute(uint8_t c, uint8_t rs) {
+    if(rs == LCD_RS_DADO) {
+        tst_ddram[tst_ac / TST_POS][tst_ac % TST_POS] = c;
+        tst_ac = (uint8_t)((tst_ac + 1) % (2 * TST_POS));                       // 0x27 -> 0x40 e 0x67 -> 0x00
+    } else if(c & 0x80) {
+        c &= 0x7F;
+        if((c & 0x3F) >= TST_POS || c > 0x67)
+            tst_outros++;                                                       // Endereço fora da DDRAM
+        tst_ac = (uint8_t)((c >> 6) * TST_POS + (c & 0x3F));
+    } else if(c == _LCD_SHIFT_LEFT) {
+        tst_desloc = (uint8_t)((tst_desloc + 1) % TST_POS);
+        tst_passos[tst_qtd_passos++ % (sizeof(tst_passos) / sizeof(tst_passos[0]))] = tst_agora;
+        tst_esquerda++;
+    } else if(c == _LCD_SHIFT_RIGHT) {
+        tst_desloc = (uint8_t)((tst_desloc + TST_POS - 1) % TST_POS);
+        tst_passos[tst_qtd_passos++ % (sizeof(tst_passos) / sizeof(tst_passos[0]))] = tst_agora;
+        tst_direita++;
+    } else if(c == _LCD_RETURN_HOME) {
+        tst_ac = 0;
+        tst_desloc = 0;
+        tst_inicio++;
+    } else if(c == _LCD_CLEAR) {
+        memset(tst_ddram, ' ', sizeof(tst_ddram));
+        tst_ac = 0;
+        tst_desloc = 0;
+    } else {
+        tst_outros++;
+    }
+}
+
+void I2C_LCD_Begin(void) {
+    if(tst_transacao)
+        tst_outros++;
+    tst_transacao = 1;
+}
+
+void I2C_LCD_Enqueue(char out_char, char rs) {
+    if(!tst_transacao)
+        tst_outros++;
+    TST_Execute((uint8_t)out_char, (uint8_t)rs);
+}
+
+void I2C_LCD_Flush(void) {
+    if(!tst_transacao)
+        tst_outros++;
+    tst_transacao = 0;
+}
+
+void I2C_LCD_Cmd(char out_char) {
+    if(tst_transacao)
+        tst_outros++;
+    TST_Execute((uint8_t)out_char, LCD_RS_CMD);
+}
+
+// Caractere visível na linha (0 ou 1) e coluna (0..15)
+static uint8_t TST_Visible(unsigned int linha, unsigned int coluna) {
+    return tst_ddram[linha][(coluna + tst_desloc) % TST_POS];
+}
+
+// LCD ligado e limpo por I2C_LCD_Init
+static void TST_Reset(void) {
+    TST_Execute(_LCD_CLEAR, LCD_RS_CMD);
+    tst_esquerda = tst_direita = tst_inicio = tst_outros = 0;
+    tst_qtd_passos = 0;
+    tst_transacao = 0;
+}
+
+unsigned int tst_erros;
+
+static void TST_Fim(const char *teste, unsigned int casos, unsigned int falhas) {
+    printf("%-8s %6u casos  %s\n", teste, casos, falhas ? "FALHOU" : "ok");
+    if(falhas)
+        tst_erros++;
+}
+
+// Invariantes depois de cada FB_Task; retorna 1 se algum falhou
+static unsigned int TST_Check(void) {
+    unsigned int c, falhou = 0;
+    uint8_t esperado;
+
+    if(tst_outros || tst_transacao)                                             // Comando estranho ou lote aberto
+        falhou = 1;
+    if(fb_desloc != FB_DESCONHECIDO && fb_desloc != tst_desloc)
+        falhou = 1;
+    if(fb_cursor != FB_DESCONHECIDO &&
+       tst_ac != (fb_cursor < FB_COLUNAS ? fb_cursor : TST_POS + fb_cursor - FB_COLUNAS))
+        falhou = 1;
+    for(c = FB_COLUNAS; c < TST_POS; c++)                                       // Linha 1 escondida nunca é escrita
+        if(tst_ddram[0][c] != ' ')
+            falhou = 1;
+
+    if(!fb_sujo && fb_desloc != FB_DESCONHECIDO) {                              // Quadro enviado: tela igual a ele
+        for(c = 0; c < FB_COLUNAS; c++) {
+            esperado = c + fb_desloc < FB_COLUNAS ? fb_quadro[c + fb_desloc] : ' ';
+            if(TST_Visible(0, c) != esperado)
+                falhou = 1;
+            if(TST_Visible(1, c) != fb_quadro[FB_COLUNAS + (c + fb_desloc) % TST_POS])
+                falhou = 1;
+        }
+    }
+
+    return falhou;
+}
+
+// Roda FB_Task a cada tick por n ticks; retorna as falhas de invariante
+static unsigned int TST_Run(uint32_t n) {
+    unsigned int falhas = 0;
+
+    while(n--) {
+        FB_Task();
+        falhas += TST_Check();
+        tst_agora++;
+    }
+
+    return falhas;
+}
+
+// Texto de n caracteres distintos entre si (a faixa visível identifica a posição)
+static void TST_Text(char *s, unsigned int n) {
+    unsigned int i;
+
+    for(i = 0; i < n; i++)
+        s[i] = (char)('0' + i);                                                 // '0'..'W'
+    s[n] = 0;
+}
+
+// Tela com a linha 1 fixa e a faixa na linha 2
+static void TST_Screen(unsigned int n) {
+    char texto[TST_POS + 1];
+
+    TST_Text(texto, n);
+    FB_Clear();
+    FB_Out(1, 1, "Tendencia 3h");
+    FB_Marquee(1, texto);
+}
+
+// Tela estática com o LCD deslocado e sujo por escrita direta
+static void TST_Frame(void) {
+    unsigned int falhas = 0, inicio;
+
+    TST_Reset();
+    memset(tst_ddram[1], '#', TST_POS);
+    memset(tst_ddram[0], '#', FB_COLUNAS);
+    tst_desloc = 7;
+    tst_ac = 0x53;
+
+    FB_Clear();
+    FB_Out(1, 1, "Temperatura");
+    FB_Out(2, 3, "23.45 C");
+    FB_Invalidate();
+    inicio = tst_inicio;
+    falhas += TST_Run(RTC_HZ);
+    if(tst_inicio != inicio + 1 || tst_desloc || fb_sujo || tst_esquerda || tst_direita)
+        falhas++;
+
+    TST_Fim("Quadro", 1, falhas);
+}
+
+// Ticks esperados de cada passo a partir do primeiro FB_Task com o texto
+static unsigned int TST_Steps(uint32_t t0, unsigned int fim, uint32_t *esperado) {
+    unsigned int ciclo, k, n = 0;
+    uint32_t t = t0;
+
+    for(ciclo = 0; ciclo < TST_CICLOS; ciclo++) {
+        for(k = 0; k < fim; k++) {                                              // Ida: pausa na origem e passos
+            t += k ? FB_PASSO : FB_PAUSA;
+            esperado[n++] = t;
+        }
+        for(k = 0; k < fim; k++) {                                              // Volta: pausa na ponta e passos
+            t += k ? FB_PASSO : FB_PAUSA;
+            esperado[n++] = t;
+        }
+    }
+
+    return n;
+}
+
+// Faixas de 1 a 40 caracteres, FB_Task a cada tick ou só nos prazos
+static void TST_Marquee(unsigned char prazos) {
+    uint32_t esperado[sizeof(tst_passos) / sizeof(tst_passos[0])];
+    unsigned int falhas = 0, n, fim, qtd, i, c, vistos;
+    uint32_t t0, duracao, limite;
+
+    for(n = 1; n <= TST_POS; n++) {
+        TST_Reset();
+        FB_Invalidate();
+        TST_Screen(n);
+        tst_agora = 1000;
+        t0 = tst_agora;
+        fim = n > FB_COLUNAS ? n - FB_COLUNAS : 0;
+        qtd = TST_Steps(t0, fim, esperado);
+        duracao = (uint32_t)TST_CICLOS * 2 * (FB_PAUSA + (fim ? fim - 1 : 0) * FB_PASSO) + FB_PAUSA;
+        limite = t0 + duracao;
+        vistos = 0;
+
+        while(FB_Task())                                                        // Texto vai ao LCD antes de rolar
+            falhas += TST_Check();
+        if(prazos) {
+            // Só acorda no prazo da faixa (ou a cada 10s sem faixa)
+            while(tst_agora < limite) {
+                FB_Task();
+                falhas += TST_Check();
+                tst_agora = FB_Deadline(tst_agora + 10 * RTC_HZ);
+            }
+        } else {
+            while(tst_agora < limite) {
+                FB_Task();
+                falhas += TST_Check();
+                if(fim && tst_desloc == fim) {                                  // Fim do texto visível na ponta
+                    vistos = 1;
+                    for(c = 0; c < FB_COLUNAS; c++)
+                        if(TST_Visible(1, c) != (uint8_t)('0' + fim + c))
+                            falhas++;
+                }
+                tst_agora++;
+            }
+            if(fim && !vistos)
+                falhas++;
+        }
+
+        if(tst_esquerda != TST_CICLOS * fim || tst_direita != TST_CICLOS * fim ||
+           tst_inicio != 1 || tst_qtd_passos != qtd) {
+            printf("  %u caracteres: %u esquerda, %u direita, %u RETURN_HOME\n", n,
+                   tst_esquerda, tst_direita, tst_inicio);
+            falhas++;
+        }
+        for(i = 0; i < qtd && i < tst_qtd_passos; i++) {
+            if(tst_passos[i] != esperado[i]) {
+                printf("  %u caracteres: passo %u no tick %u, esperado %u\n", n, i,
+                       tst_passos[i] - t0, esperado[i] - t0);
+                falhas++;
+                break;
+            }
+        }
+    }
+
+    TST_Fim(prazos ? "Prazos" : "Faixa", TST_POS, falhas);
+}
+
+// Roda FB_Task até a janela chegar ao deslocamento d (ou desistir)
+static unsigned int TST_Until(unsigned int d) {
+    uint32_t limite = tst_agora + 60 * RTC_HZ;
+    unsigned int falhas = 0;
+
+    while(tst_desloc != d && tst_agora < limite)
+        falhas += TST_Run(1);
+
+    return falhas + (tst_desloc != d);
+}
+
+// Troca do texto com a janela deslocada e FB_Invalidate no meio da rolagem
+static void TST_Change(void) {
+    unsigned int falhas = 0, inicio, esquerda, direita;
+
+    // Texto de 40 na ponta; troca por um de 20 (novo fim 4): volta até 4
+    TST_Reset();
+    FB_Invalidate();
+    TST_Screen(40);
+    tst_agora = 1000;
+    falhas += TST_Until(24);
+    esquerda = tst_esquerda;
+    TST_Screen(20);
+    falhas += TST_Until(4);
+    falhas += TST_Until(0);
+    falhas += TST_Until(4);
+    if(tst_esquerda != esquerda + 4 || tst_inicio != 1)
+        falhas++;
+
+    // Texto de 10 com a janela deslocada: RETURN_HOME e para de rolar
+    TST_Screen(10);
+    inicio = tst_inicio;
+    esquerda = tst_esquerda;
+    direita = tst_direita;
+    falhas += TST_Run(10 * RTC_HZ);
+    if(tst_inicio != inicio + 1 || tst_desloc || fb_rolando ||
+       tst_esquerda != esquerda || tst_direita != direita)
+        falhas++;
+
+    // FB_Invalidate no meio da ida: RETURN_HOME, pausa e rolagem da origem
+    TST_Screen(30);
+    falhas += TST_Until(9);
+    inicio = tst_inicio;
+    FB_Invalidate();
+    falhas += TST_Run(FB_TAM / FB_LOTE + 1);                                    // Reenvio do quadro e RETURN_HOME
+    if(tst_inicio != inicio + 1 || tst_desloc)
+        falhas++;
+    falhas += TST_Run(FB_PAUSA - 2);
+    if(tst_desloc)                                                              // Ainda na pausa da origem
+        falhas++;
+    falhas += TST_Until(14);
+    if(tst_inicio != inicio + 1)
+        falhas++;
+
+    TST_Fim("Troca", 3, falhas);
+}
+
+int main(void) {
+    TST_Frame();
+    TST_Marquee(0);
+    TST_Marquee(1);
+    TST_Change();
+
+    printf(tst_erros ? "FALHOU: %u testes\n" : "OK\n", tst_erros);
+    return tst_erros != 0;
+}
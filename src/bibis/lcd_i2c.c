@@ -1,37 +1,69 @@
+#include "config.h"
 #include "lcd_i2c.h"
 
-void I2C_LCD_Cmd(char out_char) {
+#if USE_DISPLAY
 
-    char hi_n, lo_n;
-    char rs = 0x00;
+char lcd_luz = LCD_BL;                                                          //Bit P3 somado a todo byte (LCD_BL ou 0)
 
-    hi_n = out_char & 0xF0;
-    lo_n = (out_char << 4) & 0xF0;
+//Abre uma transacao I2C com o PCF8574; os bytes seguintes vao direto ao barramento
+void I2C_LCD_Begin() {
 
     I2C1_Start();
     I2C1_Is_Idle();
     I2C1_Wr(LCD_ADDR);
     I2C1_Is_Idle();
-    I2C1_Wr(hi_n | rs | 0x04 | 0x08);
-    I2C1_Is_Idle();
-    Delay_us(50);
-    I2C1_Wr(hi_n | rs | 0x00 | 0x08);
+}
+
+//Envia um nibble (bits 7..4) com pulso em E dentro da transacao aberta
+static void I2C_LCD_Nibble(char nibble, char rs) {
+
+    I2C1_Wr(nibble | rs | LCD_E | lcd_luz);                                     //E alto por um byte inteiro (~90us a 100kHz)
     I2C1_Is_Idle();
-    Delay_us(100);
-    I2C1_Wr(lo_n | rs | 0x04 | 0x08);
+    I2C1_Wr(nibble | rs | lcd_luz);                                             //Borda de descida: o HD44780 captura o nibble
     I2C1_Is_Idle();
-    Delay_us(50);
-    I2C1_Wr(lo_n | rs | 0x00 | 0x08);
+}
+
+//Acrescenta um comando (rs = LCD_RS_CMD) ou caractere (rs = LCD_RS_DADO) a transacao
+void I2C_LCD_Enqueue(char out_char, char rs) {
+
+    I2C_LCD_Nibble(out_char & 0xF0, rs);
+    I2C_LCD_Nibble((out_char << 4) & 0xF0, rs);
+
+    if(rs == LCD_RS_CMD && (out_char == _LCD_CLEAR || out_char == _LCD_RETURN_HOME))
+        Delay_ms(2);                                                            //Unicos comandos lentos (1.52ms)
+}
+
+//Fecha a transacao
+void I2C_LCD_Flush() {
+
+    I2C1_Stop();
+}
+
+//Liga ou desliga o backlight com um unico byte (E baixo: o HD44780 ignora D7..D4)
+void I2C_LCD_Backlight(char on) {
+
+    lcd_luz = on ? LCD_BL : 0;
+
+    I2C_LCD_Begin();
+    I2C1_Wr(lcd_luz);
     I2C1_Is_Idle();
-    I2C1_stop();
+    I2C_LCD_Flush();
+}
 
-    if(out_char == 0x01)Delay_ms(2);
+//Retorna 1 se o backlight esta ligado
+char I2C_LCD_Backlight_On() {
+
+    return lcd_luz != 0;
 }
 
-void I2C_LCD_Chr(char row, char column, char out_char) {
+void I2C_LCD_Cmd(char out_char) {
+
+    I2C_LCD_Begin();
+    I2C_LCD_Enqueue(out_char, LCD_RS_CMD);
+    I2C_LCD_Flush();
+}
 
-    char hi_n, lo_n;
-    char rs = 0x01;
+void I2C_LCD_Chr(char row, char column, char out_char) {
 
     switch(row){
 
@@ -49,51 +81,14 @@ void I2C_LCD_Chr(char row, char column, char out_char) {
         break;
     };
 
-    hi_n = out_char & 0xF0;
-    lo_n = (out_char << 4) & 0xF0;
-
-    I2C1_Start();
-    I2C1_Is_Idle();
-    I2C1_Wr(LCD_ADDR);
-    I2C1_Is_Idle();
-    I2C1_Wr(hi_n | rs | 0x04 | 0x08);
-    I2C1_Is_Idle();
-    Delay_us(50);
-    I2C1_Wr(hi_n | rs | 0x00 | 0x08);
-    I2C1_Is_Idle();
-    Delay_us(100);
-    I2C1_Wr(lo_n | rs | 0x04 | 0x08);
-    I2C1_Is_Idle();
-    Delay_us(50);
-    I2C1_Wr(lo_n | rs | 0x00 | 0x08);
-    I2C1_Is_Idle();
-    I2C1_stop();
+    I2C_LCD_Chr_Cp(out_char);
 }
 
 void I2C_LCD_Chr_Cp(char out_char) {
 
-    char hi_n, lo_n;
-    char rs = 0x01;
-
-    hi_n = out_char & 0xF0;
-    lo_n = (out_char << 4) & 0xF0;
-
-    I2C1_Start();
-    I2C1_Is_Idle();
-    I2C1_Wr(LCD_ADDR);
-    I2C1_Is_Idle();
-    I2C1_Wr(hi_n | rs | 0x04 | 0x08);
-    I2C1_Is_Idle();
-    Delay_us(50);
-    I2C1_Wr(hi_n | rs | 0x00 | 0x08);
-    I2C1_Is_Idle();
-    Delay_us(100);
-    I2C1_Wr(lo_n | rs | 0x04 | 0x08);
-    I2C1_Is_Idle();
-    Delay_us(50);
-    I2C1_Wr(lo_n | rs | 0x00 | 0x08);
-    I2C1_Is_Idle();
-    I2C1_stop();
+    I2C_LCD_Begin();
+    I2C_LCD_Enqueue(out_char, LCD_RS_DADO);
+    I2C_LCD_Flush();
 }
 
 void I2C_LCD_Out(char row, char col, char *text) {
@@ -106,53 +101,81 @@ void I2C_LCD_Out_Cp(char *text) {
          I2C_LCD_Chr_Cp(*text++);
 }
 
-void I2C_LCD_Init() {
+void I2C_LCD_CustomChar(char slot, const char *bitmap) {
 
-    char rs = 0x00;
+    char i;
 
-    I2C1_Start();
+    I2C_LCD_Begin();
+    I2C_LCD_Enqueue(0x40 | ((slot & 0x07) << 3), LCD_RS_CMD);
+    for(i = 0; i < 8; i++)
+         I2C_LCD_Enqueue(bitmap[i], LCD_RS_DADO);
+    I2C_LCD_Enqueue(_LCD_FIRST_ROW, LCD_RS_CMD);
+    I2C_LCD_Flush();
+}
+
+//Le um nibble do HD44780 (RW = 1); retorna D7..D4 nos bits 7..4
+static char I2C_LCD_ReadNibble(char rs) {
+
+    char v;
+
+    I2C1_Wr(0xF0 | rs | LCD_RW | LCD_E | lcd_luz);                              //D7..D4 em 1: entradas do PCF8574
     I2C1_Is_Idle();
+    I2C1_Repeated_Start();
+    I2C1_Wr(LCD_ADDR | 0x01);
+    v = I2C1_Rd(0);
+    I2C1_Repeated_Start();
     I2C1_Wr(LCD_ADDR);
+    I2C1_Wr(0xF0 | rs | LCD_RW | lcd_luz);                                      //Desce E
     I2C1_Is_Idle();
 
-    Delay_ms(3);
+    return v & 0xF0;
+}
 
-    I2C1_Wr(0x30 | rs | 0x04 | 0x08);
-    I2C1_Is_Idle();
-    Delay_us(50);
-    I2C1_Wr(0x30 | rs | 0x00 | 0x08);
-    I2C1_Is_Idle();
+//Comandos finais da inicializacao: 4 bits/2 linhas, incremento, display ligado, marca e limpeza
+static void I2C_LCD_Setup() {
 
-    Delay_ms(1);
+    I2C_LCD_Enqueue(0x28, LCD_RS_CMD);
+    I2C_LCD_Enqueue(0x06, LCD_RS_CMD);
+    I2C_LCD_Enqueue(_LCD_CURSOR_OFF, LCD_RS_CMD);
+    I2C_LCD_Enqueue(LCD_CGRAM_MARCA, LCD_RS_CMD);
+    I2C_LCD_Enqueue(LCD_MARCA, LCD_RS_DADO);
+    I2C_LCD_Enqueue(_LCD_CLEAR, LCD_RS_CMD);                                    //Tambem volta ao endereco 0 da DDRAM
+}
 
-    I2C1_Wr(0x30 | rs | 0x04 | 0x08);
-    I2C1_Is_Idle();
-    Delay_us(50);
-    I2C1_Wr(0x30 | rs | 0x00 | 0x08);
-    I2C1_Is_Idle();
+//Inicializacao completa: ressincroniza o HD44780 (8 bits) e passa para 4 bits
+void I2C_LCD_Init() {
 
-    Delay_ms(1);
+    I2C_LCD_Begin();
 
-    I2C1_Wr(0x30 | rs | 0x04 | 0x08);
-    I2C1_Is_Idle();
-    Delay_us(50);
-    I2C1_Wr(0x30 | rs | 0x00 | 0x08);
-    I2C1_Is_Idle();
+    I2C_LCD_Nibble(0x30, LCD_RS_CMD);
+    Delay_us(4100);                                                             //Primeiro 0x3: espera > 4.1ms
+    I2C_LCD_Nibble(0x30, LCD_RS_CMD);                                           //Os 2 bytes do nibble (180us) cobrem os 100us
+    I2C_LCD_Nibble(0x30, LCD_RS_CMD);
+    I2C_LCD_Nibble(0x20, LCD_RS_CMD);                                           //Modo de 4 bits
 
-    Delay_ms(1);
+    I2C_LCD_Setup();
+    I2C_LCD_Flush();
+}
 
-    I2C1_Wr(0x20 | rs | 0x04 | 0x08);
-    I2C1_Is_Idle();
-    Delay_us(50);
-    I2C1_Wr(0x20 | rs | 0x00 | 0x08);
-    I2C1_Is_Idle();
-    I2C1_Stop();
+//Partida a quente: se o display ainda esta em 4 bits com a marca gravada na
+//CGRAM, so refaz a configuracao; retorna 0 se for preciso chamar I2C_LCD_Init
+char I2C_LCD_Resume() {
 
-    Delay_ms(1);
+    char marca;
 
-    I2C_LCD_Cmd(0x28);
-    I2C_LCD_Cmd(0x06);
+    I2C_LCD_Begin();
+    I2C_LCD_Enqueue(LCD_CGRAM_MARCA, LCD_RS_CMD);
+    marca = I2C_LCD_ReadNibble(LCD_RS_DADO);
+    marca |= I2C_LCD_ReadNibble(LCD_RS_DADO) >> 4;
 
-    I2C_LCD_Cmd(_LCD_CURSOR_OFF);
-    I2C_LCD_Cmd(_LCD_CLEAR);
+    if(marca != LCD_MARCA) {                                                    //Em 8 bits, fora de fase ou desligado
+        I2C_LCD_Flush();
+        return 0;
+    }
+
+    I2C_LCD_Setup();
+    I2C_LCD_Flush();
+    return 1;
 }
+
+#endif
@@ -1,8 +1,19 @@
 #ifndef LCD_I2C_H
 #define LCD_I2C_H
 
-// --- Definies do LCD_I2C ---
-#define LCD_ADDR 0x4E                                                           //Endereo do hardware I2C
+// --- Definições do LCD_I2C ---
+#define LCD_ADDR 0x4E                                                           //Endereço do hardware I2C
+
+// --- Pinos do PCF8574 ---
+#define LCD_RS_CMD              0x00                                            //P0 = 0: comando
+#define LCD_RS_DADO             0x01                                            //P0 = 1: caractere
+#define LCD_RW                  0x02                                            //P1: leitura do HD44780
+#define LCD_E                   0x04                                            //P2: enable
+#define LCD_BL                  0x08                                            //P3: backlight
+
+// --- Marca de partida a quente (linha 7 do caractere 7 da CGRAM, nao usado na tela) ---
+#define LCD_CGRAM_MARCA         0x7F                                            //Set CGRAM address 0x3F
+#define LCD_MARCA               0x15                                            //Valor gravado por I2C_LCD_Init (5 bits)
 
 // --- Comandos do LCD_I2C ---
 #define _LCD_FIRST_ROW          0x80                                            //Move cursor to the 1st row
@@ -22,11 +33,23 @@
 #define _LCD_SHIFT_LEFT         0x18                                            //Shift display left without changing display data RAM
 #define _LCD_SHIFT_RIGHT        0x1E                                            //Shift display right without changing display data RAM
 
+// Lote de comandos: I2C_LCD_Begin abre uma transacao, cada I2C_LCD_Enqueue envia
+// os dois nibbles direto ao barramento (sem buffer em RAM) e I2C_LCD_Flush fecha.
+// Cada byte I2C leva ~90us a 100kHz: o pulso em E e o intervalo entre comandos
+// ja passam dos 450ns/37us do HD44780, entao so CLEAR e RETURN_HOME esperam
+
 // Prototipos de funcoes
+void I2C_LCD_Begin();                                                           //Abre transacao de lote
+void I2C_LCD_Enqueue(char out_char, char rs);                                   //Acrescenta comando ou caractere ao lote
+void I2C_LCD_Flush();                                                           //Fecha transacao de lote
 void I2C_LCD_Cmd(char out_char);
 void I2C_LCD_Chr(char row, char column, char out_char);                         //Apresentacao de caracter no LCD atraves de apontamento
 void I2C_LCD_Chr_Cp(char out_char);                                             //Apresentacao de caracter no LCD
 void I2C_LCD_Out(char row, char col, char *text);                               //Apresentacao de string no LCD atraves de apontamento
 void I2C_LCD_Out_Cp(char *text);                                                //Apresentacao de string no LCD
+void I2C_LCD_CustomChar(char slot, const char *bitmap);                         //Grava caractere customizado (0..7) na CGRAM
 void I2C_LCD_Init();                                                            //Prototipo da funcao de inicializacao do LCD
+char I2C_LCD_Resume();                                                          //Partida a quente: 1 = display ja estava em 4 bits
+void I2C_LCD_Backlight(char on);                                                //Liga (1) ou desliga (0) o backlight sem mexer no conteudo
+char I2C_LCD_Backlight_On();                                                    //1 = backlight ligado
 #endif
\ No newline at end of file
@@ -0,0 +1,92 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+###############################################################################
+# Ferramenta: Memória ocupada por perfil de compilação (memoria.py)
+# Autor: Elison Nogueira
+# Data: 18/10/2026
+# Versão: 1.0
+# Plataforma: PC (Python 3), não faz parte do firmware
+#
+# Descrição:
+# Lê a saída do mikroC de cada perfil (config.h) e imprime as linhas de ROM
+# e RAM da tabela de perfis do readme. Para cada perfil:
+#
+#   Arquivo   Fornece
+#   .hex      ROM: bytes gravados na flash (0x0000..0x7FFF), sem a palavra
+#             de configuração (0x300000) e a EEPROM (0xF00000)
+#   .log      ROM e RAM do resumo do mikroC ("Used ROM (bytes): n" e
+#             "Used RAM (bytes): n"), se o log estiver ao lado do .hex
+#
+# A RAM só existe no log: o .hex não diz quanto da RAM o ligador usou. Com
+# o log presente, a ROM do log é a que vai para a tabela e a do .hex serve
+# de conferência.
+#
+# Como gerar os arquivos: compile o projeto no mikroC com USE_DISPLAY = 1,
+# copie BME280_With_PIC18F25K50.hex e .log para outro nome, compile com
+# USE_DISPLAY = 0 e rode este script com os dois pares.
+#
+# Uso: python3 memoria.py Nome=arquivo.hex [Nome=arquivo.hex ...]
+#   ex.: python3 memoria.py Display=display.hex "Sem display=headless.hex"
+###############################################################################
+
+import os
+import re
+import sys
+
+FLASH = 0x8000                                                                  # 32KB do PIC18F25K50
+RAM = 2048                                                                      # RAM de dados do PIC18F25K50
+
+
+# Bytes gravados abaixo de FLASH num Intel HEX
+def rom_hex(caminho):
+    base = 0
+    usados = 0
+    with open(caminho) as f:
+        for linha in f:
+            linha = linha.strip()
+            if not linha.startswith(':'):
+                continue
+            qtd = int(linha[1:3], 16)
+            endereco = int(linha[3:7], 16)
+            tipo = int(linha[7:9], 16)
+            if tipo == 4:                                                       # Endereço linear estendido
+                base = int(linha[9:13], 16) << 16
+            elif tipo == 0 and base + endereco < FLASH:
+                usados += min(qtd, FLASH - base - endereco)
+    return usados
+
+
+# ROM e RAM do resumo do mikroC (None se não houver log)
+def uso_log(caminho):
+    if not os.path.exists(caminho):
+        return None, None
+    with open(caminho, encoding='latin-1') as f:
+        texto = f.read()
+    rom = re.search(r'Used ROM \(bytes\):\s*(\d+)', texto)
+    ram = re.search(r'Used RAM \(bytes\):\s*(\d+)', texto)
+    return (int(rom.group(1)) if rom else None,
+            int(ram.group(1)) if ram else None)
+
+
+def celula(valor, total):
+    if valor is None:
+        return 'sem .log'
+    return '%d bytes (%d%%)' % (valor, round(100 * valor / total))
+
+
+perfis = []
+for arg in sys.argv[1:]:
+    nome, _, caminho = arg.rpartition('=')
+    if not nome:
+        sys.exit('uso: python3 memoria.py Nome=arquivo.hex [Nome=arquivo.hex ...]')
+    rom = rom_hex(caminho)
+    rom_log, ram_log = uso_log(os.path.splitext(caminho)[0] + '.log')
+    perfis.append((nome, rom, rom_log, ram_log))
+if not perfis:
+    sys.exit('uso: python3 memoria.py Nome=arquivo.hex [Nome=arquivo.hex ...]')
+
+print('| Item | ' + ' | '.join(p[0] for p in perfis) + ' |')
+print('|------|' + '|'.join('-' * (len(p[0]) + 2) for p in perfis) + '|')
+print('| ROM (mikroC) | ' + ' | '.join(celula(p[2], FLASH) for p in perfis) + ' |')
+print('| ROM (.hex) | ' + ' | '.join(celula(p[1], FLASH) for p in perfis) + ' |')
+print('| RAM (mikroC) | ' + ' | '.join(celula(p[3], RAM) for p in perfis) + ' |')
@@ -0,0 +1,154 @@
+/******************************************************************************
+ * Biblioteca: Multiplicações no multiplicador 8x8 (mult.c)
+ * Autor: Elison Nogueira
+ * Data: 18/10/2026
+ * Versão: 1.0
+ * Plataforma: PIC18F25K50 (Microchip)
+ * Compilador: mikroC Pro for PIC v7.6.0
+ *
+ * Descrição:
+ * Produtos 32x16 e 16x16 montados com MULWF. Veja mult.h.
+ ******************************************************************************/
+
+#include "mult.h"
+
+#if USE_MUL_8X8
+
+// Palavra de 32 bits vista por bytes e por metades
+typedef union {
+    unsigned char b[4];
+    unsigned int w[2];
+    unsigned long l;
+} mul_32;
+
+// PRODH:PRODL = x * y (o operando y fica no próprio PRODL)
+#define MUL_8X8(x, y)   PRODL = (y); WREG = (x); asm MULWF PRODL, 0
+
+// Produto completo de dois fatores de 16 bits sem sinal
+unsigned long MUL_16x16U(unsigned int a, unsigned int b) {
+    mul_32 r, m;
+    unsigned char a0, a1, b0, b1;
+
+    a0 = Lo(a);
+    a1 = Hi(a);
+    b0 = Lo(b);
+    b1 = Hi(b);
+
+    MUL_8X8(a0, b0);                                                            // Bytes 0..1
+    r.b[0] = PRODL;
+    r.b[1] = PRODH;
+    MUL_8X8(a1, b1);                                                            // Bytes 2..3
+    r.b[2] = PRODL;
+    r.b[3] = PRODH;
+
+    m.b[0] = 0;                                                                 // Termos cruzados entram nos bytes 1..2
+    m.b[3] = 0;
+    MUL_8X8(a0, b1);
+    m.b[1] = PRODL;
+    m.b[2] = PRODH;
+    r.l += m.l;
+    MUL_8X8(a1, b0);
+    m.b[1] = PRODL;
+    m.b[2] = PRODH;
+    r.l += m.l;
+
+    return r.l;
+}
+
+// 32 bits de baixo de a * b, com b sem sinal
+long MUL_32xU16(long a, unsigned int b) {
+    mul_32 x, r, h;
+    unsigned char b0, b1;
+
+    x.l = a;
+    b0 = Lo(b);
+    b1 = Hi(b);
+
+    r.l = MUL_16x16U(x.w[0], b);                                                // Metade baixa de a: produto completo
+
+    // Metade alta de a: só os 16 bits de baixo do produto chegam ao resultado
+    MUL_8X8(x.b[2], b0);
+    h.b[0] = PRODL;
+    h.b[1] = PRODH;
+    MUL_8X8(x.b[3], b0);                                                        // Destes dois só o byte baixo conta
+    h.b[1] += PRODL;
+    MUL_8X8(x.b[2], b1);
+    h.b[1] += PRODL;
+
+    r.w[1] += h.w[0];
+
+    return r.l;
+}
+
+// 32 bits de baixo de a * b, com b com sinal
+long MUL_32x16(long a, int b) {
+    mul_32 x, r;
+
+    r.l = MUL_32xU16(a, b);                                                     // b lido sem sinal vale b + 65536 se negativo
+    if(b < 0) {
+        x.l = a;
+        r.w[1] -= x.w[0];                                                       // Tira a * 65536
+    }
+
+    return r.l;
+}
+
+// Soma o produto x.b[i] * y.b[j] à coluna atual
+#define MUL_ACC(i, j)   MUL_8X8(x.b[i], y.b[j]); p.b[0] = PRODL; p.b[1] = PRODH; acc.l += p.l
+
+// Fecha a coluna: o byte baixo sai e o resto é o vai-um da próxima
+#define MUL_COLUNA()    acc.b[0] = acc.b[1]; acc.b[1] = acc.b[2]; acc.b[2] = acc.b[3]; acc.b[3] = 0
+
+// 32 bits de cima do produto de 64 bits, somando por colunas de bytes
+unsigned long MUL_High32(unsigned long a, unsigned long b) {
+    mul_32 x, y, p, acc, r;
+
+    x.l = a;
+    y.l = b;
+    p.l = 0;
+    acc.l = 0;
+
+    MUL_ACC(0, 0);                                                              // Colunas 0..3: só o vai-um importa
+    MUL_COLUNA();
+    MUL_ACC(0, 1);
+    MUL_ACC(1, 0);
+    MUL_COLUNA();
+    MUL_ACC(0, 2);
+    MUL_ACC(1, 1);
+    MUL_ACC(2, 0);
+    MUL_COLUNA();
+    MUL_ACC(0, 3);
+    MUL_ACC(1, 2);
+    MUL_ACC(2, 1);
+    MUL_ACC(3, 0);
+    MUL_COLUNA();
+    MUL_ACC(1, 3);                                                              // Colunas 4..7: o resultado
+    MUL_ACC(2, 2);
+    MUL_ACC(3, 1);
+    r.b[0] = acc.b[0];
+    MUL_COLUNA();
+    MUL_ACC(2, 3);
+    MUL_ACC(3, 2);
+    r.b[1] = acc.b[0];
+    MUL_COLUNA();
+    MUL_ACC(3, 3);
+    r.b[2] = acc.b[0];
+    r.b[3] = acc.b[1];
+
+    return r.l;
+}
+
+// 32 bits de baixo de a * a; 16x16 quando |a| cabe em 16 bits
+unsigned long MUL_Square(long a) {
+    mul_32 x;
+
+    if(a < 0)
+        a = -a;                                                                 // -2^31 continua -2^31 e vai ao genérico
+    x.l = a;
+    if(x.w[1] == 0)
+        return MUL_16x16U(x.w[0], x.w[0]);
+
+    return (unsigned long)a * (unsigned long)a;
+}
+
+#endif
@@ -0,0 +1,68 @@
+/******************************************************************************
+ * Biblioteca: Multiplicações no multiplicador 8x8 (mult.h)
+ * Autor: Elison Nogueira
+ * Data: 18/10/2026
+ * Versão: 1.0
+ * Plataforma: PIC18F25K50 (Microchip)
+ * Compilador: mikroC Pro for PIC v7.6.0
+ *
+ * Descrição:
+ * Multiplicações da compensação do BME280 (bme280.c) em que um dos fatores
+ * é um coeficiente de calibração de 16 bits ou menos. O compilador trata
+ * todo long * long como 32x32 genérico; aqui cada rotina usa só os produtos
+ * parciais 8x8 (MULWF, um ciclo) que chegam aos 32 bits do resultado:
+ *
+ *   Rotina        Fatores                      Produtos 8x8   Resultado
+ *   MUL_16x16U    16 x 16 sem sinal            4              32 bits exato
+ *   MUL_32xU16    32 x 16 sem sinal            7              32 bits de baixo
+ *   MUL_32x16     32 x 16 com sinal            7              32 bits de baixo
+ *   MUL_Square    Quadrado de 32 bits          4 se |a|<2^16  32 bits de baixo
+ *   MUL_High32    32 x 32 sem sinal            16             32 bits de cima
+ *
+ * Os 32 bits de baixo de um produto não dependem do sinal dos fatores; o
+ * fator de 16 bits com sinal só exige tirar a * 65536 quando é negativo.
+ * O resultado é bit a bit o mesmo do long * long do compilador, inclusive
+ * quando o produto não cabe em 32 bits. MUL_Square é para os quadrados que a
+ * análise de faixas (bme280_faixas.py) mostra caberem em 16 bits de módulo;
+ * fora disso ele cai no 32x32 genérico e o resultado continua o mesmo.
+ * MUL_High32 serve à divisão pelo recíproco da pressão; sem USE_MUL_8X8 a
+ * pressão volta à divisão do compilador e ela não existe.
+ * bme280_teste.c (teste_host.py) confere as cinco rotinas no host contra o produto de 64
+ * bits (cantos de 8, 16 e 32 bits e 20 milhões de pares sorteados).
+ *
+ * Com USE_MUL_8X8 = 0 (config.h) as rotinas viram as multiplicações
+ * genéricas, para comparar o tempo da compensação (slot COMPENSACAO do
+ * comando PERF) antes e depois. O custo de cada rotina contra o long * long
+ * do compilador é medido no PIC pelo comando WCET (perfil USE_WCET, linhas
+ * M32x16, M32xU16, M16x16U e MLONG em ciclos por chamada, mesmos operandos);
+ * a contagem estática de instruções sai da listagem do mikroC.
+ *
+ * Dependências:
+ * - Multiplicador por hardware do PIC18 (PRODH:PRODL)
+ *****************************************************************************/
+
+#ifndef MULT_H
+#define MULT_H
+
+#include "config.h"
+
+#if USE_MUL_8X8
+
+// Protótipos das funções
+unsigned long MUL_16x16U(unsigned int a, unsigned int b);                       // Produto completo de 16 x 16 sem sinal
+long MUL_32xU16(long a, unsigned int b);                                        // 32 bits de baixo de a * b (b sem sinal)
+long MUL_32x16(long a, int b);                                                  // 32 bits de baixo de a * b (b com sinal)
+unsigned long MUL_Square(long a);                                               // 32 bits de baixo de a * a
+unsigned long MUL_High32(unsigned long a, unsigned long b);                     // 32 bits de cima de a * b
+
+#else
+
+// Rotinas genéricas do compilador (referência para a medida)
+#define MUL_16x16U(a, b)  ((unsigned long)(a) * (unsigned long)(b))
+#define MUL_32xU16(a, b)  ((long)(a) * (long)(b))
+#define MUL_32x16(a, b)   ((long)(a) * (long)(b))
+#define MUL_Square(a)     ((unsigned long)(a) * (unsigned long)(a))
+
+#endif
+
+#endif
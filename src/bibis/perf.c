@@ -0,0 +1,66 @@
+/******************************************************************************
+ * Biblioteca: Medida de tempo de execução (perf.c)
+ * Autor: Elison Nogueira
+ * Data: 18/10/2026
+ * Versão: 1.0
+ * Plataforma: PIC18F25K50 (Microchip)
+ * Compilador: mikroC Pro for PIC v7.6.0
+ *
+ * Descrição:
+ * Cronômetro no Timer0 e slots de medidas. Veja perf.h.
+ ******************************************************************************/
+
+#include "perf.h"
+
+unsigned int perf_ultima[PERF_QTD];                                             // Última medida de cada slot (us)
+unsigned int perf_maior[PERF_QTD];                                              // Maior medida de cada slot (us)
+
+// Liga o Timer0 em 16 bits a Fosc/4/4 (1us por contagem) e zera os slots
+void PERF_Init(void) {
+    unsigned char i;
+
+    T0CON = 0x81;                                                               // Ligado, 16 bits, Fosc/4, prescaler 1:4
+    TMR0IE_bit = 0;                                                             // Só o flag é usado (estouro = saturação)
+
+    for(i = 0; i < PERF_QTD; i++) {
+        perf_ultima[i] = 0;
+        perf_maior[i] = 0;
+    }
+}
+
+// Zera o cronômetro
+void PERF_Start(void) {
+    TMR0H = 0;                                                                  // TMR0H é escrito junto com TMR0L
+    TMR0L = 0;
+    TMR0IF_bit = 0;
+}
+
+// Retorna os microssegundos desde PERF_Start (65535 se estourou)
+unsigned int PERF_Elapsed(void) {
+    unsigned int us;
+
+    us = TMR0L;                                                                 // TMR0L primeiro: trava TMR0H
+    us |= (unsigned int)TMR0H << 8;
+
+    if(TMR0IF_bit)
+        return 0xFFFF;
+
+    return us;
+}
+
+// Guarda uma medida no slot
+void PERF_Save(unsigned char slot, unsigned int us) {
+    perf_ultima[slot] = us;
+    if(us > perf_maior[slot])
+        perf_maior[slot] = us;
+}
+
+// Retorna a última medida do slot
+unsigned int PERF_Last(unsigned char slot) {
+    return perf_ultima[slot];
+}
+
+// Retorna a maior medida do slot
+unsigned int PERF_Max(unsigned char slot) {
+    return perf_maior[slot];
+}
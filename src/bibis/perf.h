@@ -0,0 +1,60 @@
+/******************************************************************************
+ * Biblioteca: Medida de tempo de execução (perf.h)
+ * Autor: Elison Nogueira
+ * Data: 18/10/2026
+ * Versão: 1.0
+ * Plataforma: PIC18F25K50 (Microchip)
+ * Compilador: mikroC Pro for PIC v7.6.0
+ *
+ * Descrição:
+ * Cronômetro de microssegundos no Timer0 (16 bits, Fosc/4 com prescaler
+ * 1:4 = 1MHz a 16MHz) para medir trechos curtos do firmware em campo, sem
+ * analisador lógico. PERF_Start zera o contador e PERF_Elapsed lê o tempo
+ * decorrido, saturando em 65535us. Cada medida nomeada tem um slot que
+ * guarda o último valor e o maior já visto; o comando PERF da serial
+ * (cmd.h) lista os slots.
+ *
+ *   Slot              Trecho medido
+ *   PERF_LCD_FRIO     Partida completa do LCD (ressincronização em 8 bits)
+ *   PERF_LCD_QUENTE   Partida a quente do LCD (I2C_LCD_Resume bem-sucedido)
+ *   PERF_VARIO        Amostra do variômetro (VAR_Sample) mais o redesenho
+ *                     que ela pede; MAX acima de 62500us perde os 16Hz
+ *   PERF_PIPE + e     Estágio e da cadeia das amostras (pipeline.h); o de
+ *                     COMPENSACAO serve para comparar USE_MUL_8X8
+ *   PERF_COMP_LIVRE   Compensação sem a espera do tempo constante (só com
+ *                     USE_CONST_TIME); COMPENSACAO menos ele é a espera, e
+ *                     MAX acima do orçamento (GET, ORC=) é estouro
+ *
+ * O tempo inclui as interrupções atendidas no trecho. O Timer0 para em
+ * SLEEP: não meça trechos que chamem SCH_Idle.
+ *
+ * Dependências:
+ * - Timer0 (uso exclusivo)
+ *****************************************************************************/
+
+#ifndef PERF_H
+#define PERF_H
+
+#include "pipeline.h"
+
+// Slots de medida
+#define PERF_LCD_FRIO     0
+#define PERF_LCD_QUENTE   1
+#define PERF_VARIO        2                                                     // Amostra do variômetro com redesenho
+#define PERF_PIPE         3                                                     // Estágio e da cadeia: PERF_PIPE + e
+#if USE_CONST_TIME
+#define PERF_COMP_LIVRE   (PERF_PIPE + PIPE_QTD)                                // Compensação sem a espera
+#define PERF_QTD          (PERF_PIPE + PIPE_QTD + 1)                            // Número de slots
+#else
+#define PERF_QTD          (PERF_PIPE + PIPE_QTD)                                // Número de slots
+#endif
+
+// Protótipos das funções
+void PERF_Init(void);                                                           // Liga o Timer0 a 1MHz e zera os slots
+void PERF_Start(void);                                                          // Zera o cronômetro
+unsigned int PERF_Elapsed(void);                                                // Microssegundos desde PERF_Start (satura)
+void PERF_Save(unsigned char slot, unsigned int us);                            // Guarda a medida (última e maior)
+unsigned int PERF_Last(unsigned char slot);                                     // Última medida do slot (us)
+unsigned int PERF_Max(unsigned char slot);                                      // Maior medida do slot (us)
+
+#endif
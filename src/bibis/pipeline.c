@@ -0,0 +1,135 @@
+/******************************************************************************
+ * Biblioteca: Cadeia de processamento das amostras (pipeline.c)
+ * Autor: Elison Nogueira
+ * Data: 18/10/2026
+ * Versão: 1.0
+ * Plataforma: PIC18F25K50 (Microchip)
+ * Compilador: mikroC Pro for PIC v7.6.0
+ *
+ * Descrição:
+ * Estágios da leitura do sensor e a sequência montada por PIPE_ESTAGIOS.
+ * Veja pipeline.h.
+ ******************************************************************************/
+
+#include "pipeline.h"
+#include "config.h"
+#include "bme280.h"
+#include "rtc.h"
+#include "historico.h"
+#include "alarme.h"
+#include "previsao.h"
+#include "adaptativo.h"
+#include "saude.h"
+#include "interface.h"
+#include "perf.h"
+#include "vario.h"
+#include "ajustes.h"
+#if USE_USB_HID
+#include "usb_sensor.h"
+#endif
+
+// Medida forçada e leitura dos brutos
+static unsigned char PIPE_Acquire(amostra_bme280 *a) {
+    // O variômetro mantém o sensor em modo normal e lê os brutos a 16Hz
+    if(VAR_Active())
+        return 1;
+
+    // Nos níveis de baixo consumo o sensor dorme entre leituras
+    if(ADPT_Forced())
+        BME280_ForcedMeasurement();
+
+    // Lê os brutos; a compensação só roda no canal pedido e se ele mudou
+    BME280_Update();
+
+    // Leitura que repetiu a conversão anterior não é agregada de novo
+    return BME280_Fresh();
+}
+
+#if USE_CONST_TIME
+// Espera até o orçamento contado desde o início do estágio (PERF_Start)
+unsigned int PIPE_Pad(void) {
+    unsigned int livre;
+
+    livre = PERF_Elapsed();
+    while(PERF_Elapsed() < ajustes.orcamento);                                  // Orçamento 0 (não medido): não espera
+
+    return livre;
+}
+#endif
+
+// Temperatura, umidade e pressão compensadas
+static unsigned char PIPE_Compensate(amostra_bme280 *a) {
+    ReadTemperature(&a->temperatura);
+    ReadHumidity(&a->umidade);
+    ReadPressure(&a->pressao);
+#if USE_CONST_TIME
+    PERF_Save(PERF_COMP_LIVRE, PIPE_Pad());                                     // Compensação sem a espera
+#endif
+
+    return 1;
+}
+
+// Amostra com falha não alimenta alarmes, previsor nem histórico
+static unsigned char PIPE_Check(amostra_bme280 *a) {
+    if(HLTH_Check(a->temperatura, a->umidade, a->pressao)) {
+#if USE_USB_HID
+        HIDS_Fault();
+#endif
+        UI_Refresh();
+        return 0;
+    }
+
+    return 1;
+}
+
+// Avalia os alarmes imediatamente após a amostra
+static unsigned char PIPE_Alarms(amostra_bme280 *a) {
+    ALM_Evaluate(a->temperatura, a->umidade, a->pressao);
+
+    return 1;
+}
+
+// Tendência de pressão do previsor e taxa de amostragem adaptativa
+static unsigned char PIPE_Derive(amostra_bme280 *a) {
+    PREV_Add(a->ts, a->pressao);
+    if(!VAR_Active())                                                           // Mudar o nível reconfiguraria o sensor
+        ADPT_Update(a->ts, a->temperatura, a->umidade, a->pressao);
+
+    return 1;
+}
+
+// Guarda a amostra com timestamp no histórico
+static unsigned char PIPE_Log(amostra_bme280 *a) {
+    HIST_Add(a);
+
+    return 1;
+}
+
+// Mínimos/máximos, página atual e relatórios HID
+static unsigned char PIPE_Publish(amostra_bme280 *a) {
+    UI_Sample(a);
+#if USE_USB_HID
+    HIDS_Publish(a);
+#endif
+
+    return 1;
+}
+
+// Executa um estágio medindo o tempo; o retorno 0 encerra a cadeia
+#define PIPE_CHAMA(nome, funcao)                                               \
+    PERF_Start();                                                              \
+    continua = PIPE_##funcao(&amostra);                                        \
+    PERF_Save(PERF_PIPE + PIPE_##nome, PERF_Elapsed());                        \
+    if(!continua)                                                              \
+        return;
+
+// Lê o sensor e leva a amostra por todos os estágios, em ordem
+void PIPE_Run(void) {
+    amostra_bme280 amostra;
+    unsigned char continua;
+
+    // Marca o instante da leitura
+    amostra.ts = RTC_Now();
+
+    PIPE_ESTAGIOS(PIPE_CHAMA)
+}
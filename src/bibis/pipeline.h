@@ -0,0 +1,102 @@
+/******************************************************************************
+ * Biblioteca: Cadeia de processamento das amostras (pipeline.h)
+ * Autor: Elison Nogueira
+ * Data: 18/10/2026
+ * Versão: 1.0
+ * Plataforma: PIC18F25K50 (Microchip)
+ * Compilador: mikroC Pro for PIC v7.6.0
+ *
+ * Descrição:
+ * Caminho de cada leitura do sensor, do barramento I2C até as saídas, como
+ * uma lista fixa de estágios executados em ordem sobre a mesma amostra:
+ *
+ *   Estágio       Trabalho                                 Interrompe se
+ *   AQUISICAO     Medida forçada (se o nível pede) e       Conversão repetida
+ *                 rajada I2C dos brutos (BME280_Update);
+ *                 com o variômetro, os brutos dele
+ *   COMPENSACAO   T, UR e P compensadas (sob demanda)      -
+ *   SAUDE         Verificações de saude.h; na falha        Amostra com falha
+ *                 avisa a interface e o HID
+ *   ALARMES       ALM_Evaluate                             -
+ *   DERIVADOS     Tendência do previsor e taxa adaptativa  -
+ *                 (parada com o variômetro)
+ *   REGISTRO      Histórico com timestamp                  -
+ *   SAIDAS        Página do display e relatórios HID       -
+ *
+ * A lista é montada na compilação (PIPE_ESTAGIOS, X-macro): PIPE_Run vira
+ * uma sequência de chamadas diretas, sem ponteiro de função por amostra, e
+ * a mesma lista gera os índices dos estágios, os slots de medida (perf.h) e
+ * os nomes do comando PERF (cmd.h). Para acrescentar, tirar ou reordenar um
+ * estágio basta mudar a lista e escrever a função PIPE_<Funcao> em
+ * pipeline.c. Cada estágio recebe a amostra e retorna 0 para encerrar a
+ * cadeia naquela leitura.
+ *
+ * Cada estágio tem o seu slot de tempo (último e maior, em us no Timer0;
+ * 1us = 4 ciclos de instrução a 16MHz).
+ *
+ * Com USE_CONST_TIME (config.h) o estágio COMPENSACAO termina sempre no
+ * mesmo tempo: depois da compensação ele espera no Timer0 até o orçamento
+ * (ajustes.orcamento). A compensação varia com os dados (divisões de long
+ * em software, ramos da pressão, parte fixa e recíproco só quando t_fine
+ * muda, canal sem mudança não compensa); a espera cobre tudo isso.
+ *
+ * O orçamento é medido na bancada, num passo só: com USE_WCET o comando
+ * WCET (wcet.h) varre as entradas com o estágio sem a espera, põe no
+ * orçamento o maior tempo visto mais 1/2^PIPE_MARGEM dele para as
+ * interrupções, e varre de novo com a espera, informando o menor e o maior
+ * tempo do estágio, o orçamento, a espera média por amostra (o custo) e os
+ * estouros. SAVE grava o orçamento com os outros ajustes; a build de campo
+ * (USE_WCET = 0) o lê da EEPROM. Com orçamento 0 (nunca medido) o estágio
+ * não espera. Medidas de campo não mexem no orçamento, porque incluem as
+ * interrupções e o fariam crescer a cada pico.
+ *
+ * Alcance: só o estágio COMPENSACAO das amostras que chegam a ele (novas e
+ * a leitura ambiental com o variômetro) é nivelado. A leitura repetida para
+ * na AQUISICAO mais cedo, os outros estágios continuam variando e a
+ * compensação do variômetro a 16Hz (VAR_Sample) não espera.
+ *
+ * No campo, o slot COMPENSACAO do PERF é o tempo com a espera e o
+ * COMP_LIVRE o tempo sem ela: a diferença é o custo da amostra, e MAX de
+ * COMP_LIVRE acima do orçamento quer dizer que alguma amostra estourou
+ * (interrupção longa) e saiu mais tarde. Sobra a incerteza de uma volta do
+ * laço de espera (poucos us) e o tempo das interrupções que caem no fim da
+ * espera.
+ *
+ * Dependências:
+ * - Módulos chamados pelos estágios (bme280, saude, alarme, previsao,
+ *   adaptativo, historico, interface, usb_sensor)
+ * - Timer0 (perf.h)
+ * - Orçamento do tempo constante nos ajustes (ajustes.h)
+ *****************************************************************************/
+
+#ifndef PIPELINE_H
+#define PIPELINE_H
+
+#include "config.h"
+
+#define PIPE_MARGEM       3                                                     // Orçamento = pior caso do WCET + 1/8 dele
+
+// Estágios em ordem: X(nome do slot, sufixo da função PIPE_<sufixo>)
+#define PIPE_ESTAGIOS(X)                                                       \
+    X(AQUISICAO,   Acquire)                                                    \
+    X(COMPENSACAO, Compensate)                                                 \
+    X(SAUDE,       Check)                                                      \
+    X(ALARMES,     Alarms)                                                     \
+    X(DERIVADOS,   Derive)                                                     \
+    X(REGISTRO,    Log)                                                        \
+    X(SAIDAS,      Publish)
+
+// Índices dos estágios (PIPE_AQUISICAO, ...) e quantidade
+#define PIPE_INDICE(nome, funcao)   PIPE_##nome,
+typedef enum {
+    PIPE_ESTAGIOS(PIPE_INDICE)
+    PIPE_QTD
+} pipe_estagio;
+
+// Protótipos das funções
+void PIPE_Run(void);                                                            // Lê o sensor e leva a amostra por todos os estágios
+#if USE_CONST_TIME
+unsigned int PIPE_Pad(void);                                                    // Espera até o orçamento desde PERF_Start; retorna o tempo antes da espera
+#endif
+
+#endif
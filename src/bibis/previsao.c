@@ -0,0 +1,139 @@
+/******************************************************************************
+ * Biblioteca: Previsão do tempo por tendência de pressão (previsao.c)
+ * Autor: Elison Nogueira
+ * Data: 18/10/2026
+ * Versão: 1.0
+ * Plataforma: PIC18F25K50 (Microchip)
+ * Compilador: mikroC Pro for PIC v7.6.0
+ *
+ * Descrição:
+ * Previsor no estilo Zambretti com tendência de pressão de 3 horas mantida
+ * de forma incremental. Veja previsao.h.
+ ******************************************************************************/
+
+#include "config.h"
+#include "previsao.h"
+#include "lcd_i2c.h"
+
+// Letras de Zambretti para Z = 1..32 (caindo 1..9, estável 10..19, subindo 20..32)
+const char prev_letras[] = "ABDHORUXZABEKNPSWXZABCFGIJLMQTYZ";
+
+#if USE_DISPLAY
+// Ícones 5x8 para a CGRAM
+const char prev_icones[7][8] = {
+    {0x04, 0x15, 0x0E, 0x1B, 0x0E, 0x15, 0x04, 0x00},                           // Sol
+    {0x08, 0x1C, 0x08, 0x0E, 0x1F, 0x1F, 0x00, 0x00},                           // Sol com nuvem
+    {0x00, 0x0C, 0x1E, 0x1F, 0x1F, 0x00, 0x00, 0x00},                           // Nuvem
+    {0x0C, 0x1E, 0x1F, 0x1F, 0x00, 0x15, 0x00, 0x0A},                           // Chuva
+    {0x04, 0x0E, 0x15, 0x04, 0x04, 0x04, 0x04, 0x00},                           // Seta para cima
+    {0x00, 0x04, 0x02, 0x1F, 0x02, 0x04, 0x00, 0x00},                           // Seta para a direita
+    {0x04, 0x04, 0x04, 0x04, 0x15, 0x0E, 0x04, 0x00}                            // Seta para baixo
+};
+#endif
+
+long prev_soma;                                                                 // Soma dos desvios na hora corrente
+unsigned int prev_n;                                                            // Amostras na hora corrente
+unsigned long prev_base;                                                        // Primeira pressão da hora (referência)
+unsigned long prev_inicio;                                                      // Timestamp do início da hora
+unsigned long prev_medias[4];                                                   // Anel de médias horárias (Pa)
+unsigned char prev_idx;                                                         // Posição da média mais recente
+unsigned char prev_horas;                                                       // Horas fechadas (satura em 4)
+previsao_tendencia prev_tendencia;                                              // Última tendência calculada
+long prev_delta;                                                                // Variação em 3 horas (Pa)
+char prev_codigo;                                                               // Letra de Zambretti
+
+// Zera o acumulador e o anel de médias
+void PREV_Init(void) {
+    prev_soma = 0;
+    prev_n = 0;
+    prev_idx = 0;
+    prev_horas = 0;
+    prev_delta = 0;
+    prev_tendencia = PREV_SEM_DADOS;
+    prev_codigo = '-';
+}
+
+// Calcula tendência e código de Zambretti (uma vez por hora)
+static void PREV_Classify(void) {
+    unsigned long p;
+    int z;
+
+    p = prev_medias[prev_idx];
+    prev_delta = (long)p - (long)prev_medias[(prev_idx + 1) & 3];               // Média de 3 horas antes
+
+    if(prev_delta < -PREV_LIMIAR) {
+        prev_tendencia = PREV_CAINDO;
+        z = 127 - (int)((p * 3) / 2500);                                        // 127 - 0.12 * P(hPa)
+        if(z < 1) z = 1;
+        if(z > 9) z = 9;
+    } else if(prev_delta > PREV_LIMIAR) {
+        prev_tendencia = PREV_SUBINDO;
+        z = 185 - (int)(p / 625);                                               // 185 - 0.16 * P(hPa)
+        if(z < 20) z = 20;
+        if(z > 32) z = 32;
+    } else {
+        prev_tendencia = PREV_ESTAVEL;
+        z = 144 - (int)((p * 13) / 10000);                                      // 144 - 0.13 * P(hPa)
+        if(z < 10) z = 10;
+        if(z > 19) z = 19;
+    }
+
+    prev_codigo = prev_letras[z - 1];
+}
+
+// Acrescenta uma amostra de pressão ao acumulador da hora corrente
+void PREV_Add(unsigned long ts, unsigned long pres) {
+    if(prev_n == 0) {                                                           // Primeira amostra da hora
+        prev_inicio = ts;
+        prev_base = pres;
+    }
+    prev_soma += (long)pres - (long)prev_base;                                  // Desvio cabe em 32 bits em qualquer taxa
+    prev_n++;
+
+    if((ts - prev_inicio) < PREV_HORA)
+        return;
+
+    // Fecha a hora: média entra no anel
+    prev_idx = (prev_idx + 1) & 3;
+    prev_medias[prev_idx] = prev_base + prev_soma / (long)prev_n;
+    prev_soma = 0;
+    prev_n = 0;
+
+    if(prev_horas < 4)
+        prev_horas++;
+    if(prev_horas == 4)                                                         // Anel completo: há média de 3 horas antes
+        PREV_Classify();
+}
+
+// Retorna a tendência das últimas 3 horas
+previsao_tendencia PREV_Trend(void) {
+    return prev_tendencia;
+}
+
+// Retorna a variação de pressão em 3 horas (Pa)
+long PREV_Delta(void) {
+    return prev_delta;
+}
+
+// Retorna a letra de Zambretti ('-' enquanto não há 3 horas de histórico)
+char PREV_Code(void) {
+    return prev_codigo;
+}
+
+// Retorna o ícone do tempo previsto a partir da letra
+unsigned char PREV_Icon(void) {
+    if(prev_codigo <= 'C' || prev_codigo == '-') return PREV_ICONE_SOL;
+    if(prev_codigo <= 'G') return PREV_ICONE_NUVEM_SOL;
+    if(prev_codigo <= 'P') return PREV_ICONE_NUVEM;
+    return PREV_ICONE_CHUVA;
+}
+
+#if USE_DISPLAY
+// Grava os ícones na CGRAM do LCD
+void PREV_LoadIcons(void) {
+    unsigned char i;
+
+    for(i = 0; i < 7; i++)
+        I2C_LCD_CustomChar(i, prev_icones[i]);
+}
+#endif
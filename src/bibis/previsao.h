@@ -0,0 +1,65 @@
+/******************************************************************************
+ * Biblioteca: Previsão do tempo por tendência de pressão (previsao.h)
+ * Autor: Elison Nogueira
+ * Data: 18/10/2026
+ * Versão: 1.0
+ * Plataforma: PIC18F25K50 (Microchip)
+ * Compilador: mikroC Pro for PIC v7.6.0
+ *
+ * Descrição:
+ * Previsor no estilo Zambretti a partir da tendência de pressão de 3 horas.
+ * A tendência é mantida de forma incremental:
+ * - Cada amostra soma a pressão no acumulador da hora corrente (O(1))
+ * - A cada hora fechada a média horária entra em um anel de 4 posições
+ * - Tendência = média da última hora - média de 3 horas antes
+ *
+ * A única divisão (média horária e número de Zambretti) acontece uma vez por
+ * hora; o custo por amostra é uma soma de 32 bits e uma comparação.
+ *
+ * Classificação da tendência (variação em 3 horas):
+ * - Subindo:  > +1.6 hPa
+ * - Caindo:   < -1.6 hPa
+ * - Estável:  entre os dois
+ *
+ * O número de Zambretti Z (1..32) vem das fórmulas clássicas com a pressão
+ * em hPa: caindo Z = 127 - 0.12P, estável Z = 144 - 0.13P, subindo
+ * Z = 185 - 0.16P. O código de previsão é a letra A..Z correspondente.
+ *****************************************************************************/
+
+#ifndef PREVISAO_H
+#define PREVISAO_H
+
+#include "config.h"
+
+#define PREV_HORA         (3600UL * 4096)                                       // Uma hora em ticks do RTC
+#define PREV_LIMIAR       160                                                   // 1.6hPa em Pa
+
+// Tendência da pressão
+typedef enum {
+    PREV_SEM_DADOS = 0,                                                         // Menos de 3 horas de histórico
+    PREV_CAINDO    = 1,
+    PREV_ESTAVEL   = 2,
+    PREV_SUBINDO   = 3
+} previsao_tendencia;
+
+// Ícones gravados na CGRAM do LCD (caracteres 0..6)
+#define PREV_ICONE_SOL        0                                                 // Tempo bom
+#define PREV_ICONE_NUVEM_SOL  1                                                 // Variável
+#define PREV_ICONE_NUVEM      2                                                 // Instável
+#define PREV_ICONE_CHUVA      3                                                 // Chuva
+#define PREV_ICONE_SOBE       4                                                 // Pressão subindo
+#define PREV_ICONE_ESTAVEL    5                                                 // Pressão estável
+#define PREV_ICONE_DESCE      6                                                 // Pressão caindo
+
+// Protótipos das funções
+void PREV_Init(void);                                                           // Zera o acumulador e o anel de médias
+void PREV_Add(unsigned long ts, unsigned long pres);                            // Acrescenta uma amostra de pressão
+previsao_tendencia PREV_Trend(void);                                            // Tendência das últimas 3 horas
+long PREV_Delta(void);                                                          // Variação em 3 horas (Pa)
+char PREV_Code(void);                                                           // Letra de Zambretti ('A'..'Z', '-' sem dados)
+unsigned char PREV_Icon(void);                                                  // Ícone do tempo previsto
+#if USE_DISPLAY
+void PREV_LoadIcons(void);                                                      // Grava os ícones na CGRAM do LCD
+#endif
+
+#endif
@@ -0,0 +1,62 @@
+/******************************************************************************
+ * Biblioteca: Relógio de tempo real (rtc.c)
+ * Autor: Elison Nogueira
+ * Data: 18/10/2026
+ * Versão: 1.0
+ * Plataforma: PIC18F25K50 (Microchip)
+ * Compilador: mikroC Pro for PIC v7.6.0
+ *
+ * Descrição:
+ * Base de tempo monotônica a partir do Timer1 com cristal de 32.768kHz.
+ * Veja rtc.h para o formato do timestamp.
+ *
+ * Dependências:
+ * - Cristal de 32.768kHz em RC0/RC1 com capacitores de carga
+ ******************************************************************************/
+
+#include "rtc.h"
+
+volatile unsigned long rtc_estouros;                                            // Estouros do Timer1 (1 a cada 2s)
+
+// Liga o Timer1 com o cristal do oscilador secundário
+void RTC_Init(void) {
+    rtc_estouros = 0;
+
+    TMR1H = 0;                                                                  // Zera a contagem
+    TMR1L = 0;
+    T1GCON = 0x00;                                                              // Sem gate
+    T1CON = 0x8F;                                                               // SOSC, 1:1, SOSCEN, assíncrono, RD16, liga
+
+    TMR1IF_bit = 0;
+    TMR1IE_bit = 1;                                                             // Interrupção de estouro
+    PEIE_bit = 1;
+    GIE_bit = 1;
+}
+
+// Trata o estouro do Timer1
+void RTC_Isr(void) {
+    if(TMR1IF_bit && TMR1IE_bit) {
+        TMR1IF_bit = 0;
+        rtc_estouros++;                                                         // Mais 2s (65536 ciclos de 32.768kHz)
+    }
+}
+
+// Retorna o timestamp atual em ticks de 1/4096 s
+unsigned long RTC_Now(void) {
+    unsigned long est;
+    unsigned int cnt;
+    unsigned char gie;
+
+    gie = INTCON & 0x80;                                                        // Preserva o estado do GIE
+    GIE_bit = 0;
+
+    cnt = TMR1L;                                                                // Ler TMR1L carrega o buffer de TMR1H (RD16)
+    cnt |= (unsigned int)TMR1H << 8;
+    est = rtc_estouros;
+    if(TMR1IF_bit && (cnt < 0x8000))                                            // Estouro ocorreu e ainda não foi atendido
+        est++;
+
+    if(gie) GIE_bit = 1;
+
+    return (est << 13) | (cnt >> 3);
+}
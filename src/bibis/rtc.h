@@ -0,0 +1,43 @@
+/******************************************************************************
+ * Biblioteca: Relógio de tempo real (rtc.h)
+ * Autor: Elison Nogueira
+ * Data: 18/10/2026
+ * Versão: 1.0
+ * Plataforma: PIC18F25K50 (Microchip)
+ * Compilador: mikroC Pro for PIC v7.6.0
+ *
+ * Descrição:
+ * Base de tempo monotônica a partir do Timer1 com cristal de 32.768kHz no
+ * oscilador secundário (SOSCI/SOSCO em RC1/RC0). O Timer1 conta de forma
+ * assíncrona e continua rodando em SLEEP. Cada estouro (2s) incrementa um
+ * contador na interrupção; o timestamp combina esse contador com os 13 bits
+ * mais significativos do TMR1:
+ *
+ *   ts = (estouros << 13) | (TMR1 >> 3)       unidade: 1/4096 s = 244us
+ *
+ * O timestamp tem 32 bits e dá a volta a cada 2^20 s (~12 dias). Intervalos
+ * devem ser calculados por subtração sem sinal (agora - antes), que continua
+ * correta através da volta para intervalos menores que 12 dias.
+ *
+ * Dependências:
+ * - Cristal de 32.768kHz em RC0/RC1 com capacitores de carga
+ * - Chamada de RTC_Isr() na rotina de interrupção
+ *****************************************************************************/
+
+#ifndef RTC_H
+#define RTC_H
+
+#define RTC_HZ            4096                                                  // Ticks por segundo
+
+// Conversão de milissegundos para ticks (resolvida em tempo de compilação)
+#define RTC_MS(ms)        ((unsigned long)(ms) * RTC_HZ / 1000)
+
+// Variável externa com o número de estouros do Timer1
+extern volatile unsigned long rtc_estouros;
+
+// Protótipos das funções
+void RTC_Init(void);                                                            // Liga o Timer1 com o oscilador secundário
+void RTC_Isr(void);                                                             // Trata o estouro do Timer1 (chamar na interrupção)
+unsigned long RTC_Now(void);                                                    // Timestamp atual em ticks de 1/4096 s
+
+#endif
@@ -0,0 +1,123 @@
+/******************************************************************************
+ * Biblioteca: Saúde do sensor (saude.c)
+ * Autor: Elison Nogueira
+ * Data: 18/10/2026
+ * Versão: 1.0
+ * Plataforma: PIC18F25K50 (Microchip)
+ * Compilador: mikroC Pro for PIC v7.6.0
+ *
+ * Descrição:
+ * Detecção de sensor ausente, congelado ou com leituras implausíveis.
+ * Veja saude.h.
+ ******************************************************************************/
+
+#include "saude.h"
+#include "bme280.h"
+
+unsigned int hlth_contador[HLTH_QTD];                                           // Ocorrências por tipo de falha
+unsigned char hlth_estado;                                                      // Falhas da última amostra
+unsigned char hlth_amostras;                                                    // Amostras até a próxima leitura do ID
+unsigned char hlth_repeticoes;                                                  // Amostras brutas repetidas seguidas
+unsigned char hlth_id_falhou;                                                   // Resultado da última leitura do ID
+unsigned char hlth_primeira;                                                    // 1 = ainda não há amostra anterior
+long hlth_adc_t, hlth_adc_p, hlth_adc_h;                                        // Valores brutos anteriores
+long hlth_t;                                                                    // Valores compensados anteriores
+unsigned long hlth_h, hlth_p;
+
+// Registra uma falha no estado e no contador
+static void HLTH_Fault(unsigned char falha) {
+    hlth_estado |= 1 << falha;
+    if(hlth_contador[falha] != 0xFFFF)
+        hlth_contador[falha]++;
+}
+
+// Retorna |a - b|
+static long HLTH_Diff(long a, long b) {
+    long d;
+
+    d = a - b;
+    return d < 0 ? -d : d;
+}
+
+// Zera estado e contadores
+void HLTH_Init(void) {
+    unsigned char i;
+
+    for(i = 0; i < HLTH_QTD; i++)
+        hlth_contador[i] = 0;
+
+    hlth_estado = 0;
+    hlth_amostras = 0;                                                          // Lê o ID já na primeira amostra
+    hlth_repeticoes = 0;
+    hlth_id_falhou = 0;
+    hlth_primeira = 1;
+}
+
+// Verifica a amostra recém-lida; retorna o mapa de falhas (0 = saudável)
+unsigned char HLTH_Check(long temp, unsigned long humi, unsigned long pres) {
+    hlth_estado = 0;
+
+    // ID do chip, a cada HLTH_PERIODO_ID amostras
+    if(hlth_amostras == 0) {
+        hlth_amostras = HLTH_PERIODO_ID;
+        hlth_id_falhou = I2C_Read8(BME280_REG_CHIPID) != BME280_CHIP_ID;
+        if(hlth_id_falhou)
+            HLTH_Fault(HLTH_ID);
+    } else if(hlth_id_falhou) {
+        hlth_estado |= 1 << HLTH_ID;                                            // Mantém até a próxima leitura
+    }
+    hlth_amostras--;
+
+    // Padrão de canal pulado em canais habilitados
+    if((BME280_cfg.T_sampling != SAMPLING_SKIPPED && adc_T == 0x80000) ||
+       (BME280_cfg.P_sampling != SAMPLING_SKIPPED && adc_P == 0x80000) ||
+       (BME280_cfg.H_sampling != SAMPLING_SKIPPED && adc_H == 0x8000))
+        HLTH_Fault(HLTH_PULADO);
+
+    // Faixa de operação. A umidade compensada é saturada em 0 e 100%, e os
+    // dois extremos são leituras reais (ar seco, neblina, condensação): só
+    // passar de 100% é impossível. Canal de umidade morto aparece como 0x8000
+    // no bruto (canal pulado, acima)
+    if(temp < HLTH_T_MIN || temp > HLTH_T_MAX ||
+       pres < HLTH_P_MIN || pres > HLTH_P_MAX ||
+       humi > HLTH_H_MAX)
+        HLTH_Fault(HLTH_FAIXA);
+
+    if(!hlth_primeira) {
+        // Valores brutos congelados
+        if(adc_T == hlth_adc_t && adc_P == hlth_adc_p && adc_H == hlth_adc_h) {
+            if(hlth_repeticoes < HLTH_REPETICOES)
+                hlth_repeticoes++;
+        } else {
+            hlth_repeticoes = 0;
+        }
+        if(hlth_repeticoes >= HLTH_REPETICOES)
+            HLTH_Fault(HLTH_TRAVADO);
+
+        // Degrau implausível
+        if(HLTH_Diff(temp, hlth_t) > HLTH_DEGRAU_T ||
+           HLTH_Diff(humi, hlth_h) > HLTH_DEGRAU_H ||
+           HLTH_Diff(pres, hlth_p) > HLTH_DEGRAU_P)
+            HLTH_Fault(HLTH_DEGRAU);
+    }
+
+    hlth_primeira = 0;
+    hlth_adc_t = adc_T;
+    hlth_adc_p = adc_P;
+    hlth_adc_h = adc_H;
+    hlth_t = temp;
+    hlth_h = humi;
+    hlth_p = pres;
+
+    return hlth_estado;
+}
+
+// Retorna o mapa de falhas da última amostra
+unsigned char HLTH_Status(void) {
+    return hlth_estado;
+}
+
+// Retorna quantas vezes a falha ocorreu desde a inicialização
+unsigned int HLTH_Count(unsigned char falha) {
+    return hlth_contador[falha];
+}
@@ -0,0 +1,57 @@
+/******************************************************************************
+ * Biblioteca: Saúde do sensor (saude.h)
+ * Autor: Elison Nogueira
+ * Data: 18/10/2026
+ * Versão: 1.0
+ * Plataforma: PIC18F25K50 (Microchip)
+ * Compilador: mikroC Pro for PIC v7.6.0
+ *
+ * Descrição:
+ * Verificações contínuas do BME280 feitas a cada amostra, com custo de
+ * algumas comparações e uma transação I2C a cada HLTH_PERIODO_ID amostras:
+ * - ID do chip relido periodicamente (sensor trocado, barramento travado)
+ * - Padrão de canal pulado nos valores brutos (0x80000 em T/P, 0x8000 em
+ *   UR): valor de reset dos registradores, indica medição que não ocorreu
+ * - Valores brutos idênticos nos três canais por HLTH_REPETICOES amostras
+ *   seguidas (o ruído do ADC torna isso improvável num sensor vivo)
+ * - Resultado compensado fora da faixa de operação do sensor (umidade em 0
+ *   ou 100%, saturada pela compensação, é leitura válida)
+ * - Degrau entre amostras consecutivas acima do fisicamente plausível
+ *
+ * Cada falha tem um bit em HLTH_Status (estado da última amostra) e um
+ * contador acumulado desde a inicialização, saturado em 65535.
+ *****************************************************************************/
+
+#ifndef SAUDE_H
+#define SAUDE_H
+
+// Tipos de falha (índice do contador e bit do estado)
+#define HLTH_ID           0                                                     // ID do chip diferente de 0x60
+#define HLTH_PULADO       1                                                     // Padrão de canal pulado no ADC
+#define HLTH_TRAVADO      2                                                     // Valores brutos congelados
+#define HLTH_FAIXA        3                                                     // Resultado fora da faixa
+#define HLTH_DEGRAU       4                                                     // Variação implausível entre amostras
+#define HLTH_QTD          5                                                     // Número de tipos de falha
+
+#define HLTH_PERIODO_ID   64                                                    // Amostras entre leituras do ID
+#define HLTH_REPETICOES   8                                                     // Repetições para considerar travado
+
+// Faixa de operação (datasheet BME280, seção 1)
+#define HLTH_T_MIN        -4000                                                 // -40°C
+#define HLTH_T_MAX        8500                                                  // 85°C
+#define HLTH_P_MIN        30000                                                 // 300hPa
+#define HLTH_P_MAX        110000                                                // 1100hPa
+#define HLTH_H_MAX        102400                                                // 100%UR (saturação é leitura válida)
+
+// Maior variação plausível entre duas amostras
+#define HLTH_DEGRAU_T     300                                                   // 3°C
+#define HLTH_DEGRAU_H     20480                                                 // 20%UR
+#define HLTH_DEGRAU_P     500                                                   // 5hPa
+
+// Protótipos das funções
+void HLTH_Init(void);                                                           // Zera estado e contadores
+unsigned char HLTH_Check(long temp, unsigned long humi, unsigned long pres);    // Verifica a amostra (0 = saudável)
+unsigned char HLTH_Status(void);                                                // Bit n = falha n na última amostra
+unsigned int HLTH_Count(unsigned char falha);                                   // Ocorrências acumuladas da falha
+
+#endif
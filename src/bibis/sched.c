@@ -0,0 +1,129 @@
+/******************************************************************************
+ * Biblioteca: Escalonador com repouso até o próximo prazo (sched.c)
+ * Autor: Elison Nogueira
+ * Data: 18/10/2026
+ * Versão: 1.0
+ * Plataforma: PIC18F25K50 (Microchip)
+ * Compilador: mikroC Pro for PIC v7.6.0
+ *
+ * Descrição:
+ * Prazos em ticks do RTC, repouso em IDLE/SLEEP acordado pelo Timer3 e
+ * medida do tempo ocioso. Veja sched.h.
+ ******************************************************************************/
+
+#include "config.h"
+#include "sched.h"
+#include "rtc.h"
+#include "interface.h"
+#include "cmd.h"
+#include "bme280.h"
+
+unsigned long sch_inicio;                                                       // Início da janela atual
+unsigned long sch_ocioso;                                                       // Ticks dormidos na janela atual
+unsigned int sch_taxa;                                                          // Ociosidade da última janela (por mil)
+unsigned int sch_novas;                                                         // BME280_NewCount() no início da janela
+unsigned int sch_amostras;                                                      // Leituras novas por segundo na última janela (centésimos)
+
+// Prepara o Timer3 no oscilador secundário e zera a medida
+void SCH_Init(void) {
+    T3GCON = 0x00;                                                              // Sem gate
+    T3CON = 0xBE;                                                               // SOSC, 1:8 (4096Hz), SOSCEN, assíncrono, RD16, desligado
+    TMR3IE_bit = 0;
+
+    sch_inicio = RTC_Now();
+    sch_ocioso = 0;
+    sch_taxa = 0;
+    sch_novas = BME280_NewCount();
+    sch_amostras = 0;
+}
+
+// Verifica se o prazo já venceu (comparação tolerante ao estouro do RTC)
+unsigned char SCH_Due(unsigned long prazo) {
+    return (long)(RTC_Now() - prazo) >= 0;
+}
+
+// Agenda o próximo prazo sem acumular atraso
+void SCH_Next(unsigned long *prazo, unsigned long periodo) {
+    unsigned long agora = RTC_Now();
+
+    *prazo += periodo;
+    if((long)(agora - *prazo) >= 0)                                             // Atrasado mais de um período
+        *prazo = agora + periodo;
+}
+
+// Fecha a janela de medida quando ela completa SCH_JANELA ticks
+static void SCH_Window(unsigned long agora) {
+    unsigned long decorrido;
+    unsigned int novas;
+
+    decorrido = agora - sch_inicio;
+    if(decorrido < SCH_JANELA)
+        return;
+
+    // Divisões só no fechamento da janela; a taxa não estoura até 65535 leituras
+    sch_taxa = (sch_ocioso * 1000) / decorrido;
+    novas = BME280_NewCount() - sch_novas;                                      // Módulo 65536
+    sch_amostras = ((unsigned long)novas * (100L * RTC_HZ / 16)) / (decorrido >> 4);
+    sch_inicio = agora;
+    sch_ocioso = 0;
+    sch_novas = BME280_NewCount();
+}
+
+// Dorme até o prazo se nenhuma tarefa tiver trabalho pendente
+void SCH_Idle(unsigned long prazo) {
+    unsigned long espera, antes, depois;
+    unsigned int carga;
+    unsigned char profundo;
+
+    GIE_bit = 0;                                                                // Fecha a corrida entre o teste e o SLEEP
+
+    espera = prazo - RTC_Now();
+    if(UI_Pending() || CMD_Pending() || (long)espera <= 0) {
+        GIE_bit = 1;
+        return;
+    }
+    if(espera > SCH_ESPERA_MAX)
+        espera = SCH_ESPERA_MAX;
+
+#if USE_USB_HID
+    profundo = 0;                                                               // O USB precisa do clock
+#else
+    profundo = !UI_Debouncing() && !CMD_Listening();
+#endif
+
+    carga = 0 - (unsigned int)espera;                                           // Estoura após 'espera' ticks
+    TMR3H = Hi(carga);                                                          // Escrita de TMR3L carrega TMR3H (RD16)
+    TMR3L = Lo(carga);
+    TMR3IF_bit = 0;
+    TMR3IE_bit = 1;                                                             // Só acorda; GIE desligado não desvia
+    TMR3ON_bit = 1;
+
+    IDLEN_bit = !profundo;
+    WUE_bit = profundo;                                                         // Borda de RX acorda do SLEEP
+
+    antes = RTC_Now();
+    asm sleep;
+    depois = RTC_Now();
+
+    WUE_bit = 0;
+    TMR3ON_bit = 0;
+    TMR3IE_bit = 0;
+    TMR3IF_bit = 0;
+
+    sch_ocioso += depois - antes;
+    SCH_Window(depois);
+
+    GIE_bit = 1;                                                                // Atende a interrupção que acordou
+}
+
+// Retorna as leituras novas por segundo da última janela completa, em centésimos
+unsigned int SCH_SampleRate(void) {
+    SCH_Window(RTC_Now());
+    return sch_amostras;
+}
+
+// Retorna a ociosidade da última janela completa em partes por mil
+unsigned int SCH_IdleRate(void) {
+    SCH_Window(RTC_Now());                                                      // Laço sem repouso também fecha a janela
+    return sch_taxa;
+}
@@ -0,0 +1,64 @@
+/******************************************************************************
+ * Biblioteca: Escalonador com repouso até o próximo prazo (sched.h)
+ * Autor: Elison Nogueira
+ * Data: 18/10/2026
+ * Versão: 1.0
+ * Plataforma: PIC18F25K50 (Microchip)
+ * Compilador: mikroC Pro for PIC v7.6.0
+ *
+ * Descrição:
+ * Laço cooperativo por prazos: cada tarefa periódica guarda o próximo prazo
+ * em ticks do RTC (SCH_Due/SCH_Next) e as demais são acordadas por
+ * interrupção. Ao fim de cada volta do laço, SCH_Idle dorme até o prazo mais
+ * próximo se nenhuma tarefa tiver trabalho pendente:
+ *
+ *   Tarefa             Pendência (não dorme)          Acorda por
+ *   Sensor/variômetro  -                              Prazo (Timer3)
+ *   Interface/LCD      Botão, redesenho ou quadro     IOC de RB4/RB5
+ *                      ainda não enviado ao LCD
+ *   Comandos (serial)  Linha completa recebida        RX da UART1
+ *   USB HID            -                              Interrupção do USB
+ *   RTC                -                              Estouro do Timer1 (2s)
+ *
+ * O Timer3 conta o cristal de 32.768kHz com prescaler 1:8, no mesmo passo
+ * do RTC (4096Hz), e seu estouro marca o prazo; espera máxima de 16s.
+ *
+ * Profundidade do repouso:
+ * - SLEEP: oscilador principal parado, só o SOSC roda. Usado quando nada
+ *   precisa de clock: sem USB, sem debounce em andamento (Timer2) e sem
+ *   tráfego recente na serial. A UART fica com WUE, e a borda de RX acorda
+ *   a CPU; o caractere dessa borda se perde (veja cmd.h).
+ * - IDLE: só a CPU para; periféricos seguem com clock.
+ *
+ * O teste de pendências e a instrução SLEEP são feitos com GIE desligado:
+ * uma interrupção entre os dois deixa o flag ligado e o SLEEP não dorme.
+ * A interrupção que acordou a CPU é atendida ao religar o GIE.
+ *
+ * O I2C da biblioteca do mikroC é por varredura (sem interrupção do MSSP),
+ * portanto nunca há transação em andamento quando o laço chega em SCH_Idle.
+ *
+ * O tempo dormido é medido com o RTC e acumulado em janelas de
+ * SCH_JANELA ticks; SCH_IdleRate() devolve a ociosidade da última janela e
+ * SCH_SampleRate() a taxa efetiva de leituras com conversão nova do BME280
+ * (STAT na serial).
+ *
+ * Dependências:
+ * - Cristal de 32.768kHz (SOSC), já ligado por RTC_Init
+ * - Timer3
+ *****************************************************************************/
+
+#ifndef SCHED_H
+#define SCHED_H
+
+#define SCH_JANELA        65536                                                 // Janela da medida de ociosidade (16s)
+#define SCH_ESPERA_MAX    65535                                                 // Maior espera do Timer3 (ticks do RTC)
+
+// Protótipos das funções
+void SCH_Init(void);                                                            // Prepara o Timer3 no SOSC
+unsigned char SCH_Due(unsigned long prazo);                                     // 1 = prazo vencido
+void SCH_Next(unsigned long *prazo, unsigned long periodo);                     // Agenda o próximo prazo sem acumular atraso
+void SCH_Idle(unsigned long prazo);                                             // Dorme até o prazo se não houver pendências
+unsigned int SCH_SampleRate(void);                                              // Leituras novas por segundo na última janela (centésimos)
+unsigned int SCH_IdleRate(void);                                                // Ociosidade da última janela (por mil)
+
+#endif
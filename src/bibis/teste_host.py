@@ -0,0 +1,129 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+###############################################################################
+# Ferramenta: Testes no host dos módulos do firmware (teste_host.py)
+# Autor: Elison Nogueira
+# Data: 18/10/2026
+# Versão: 1.0
+# Plataforma: PC (Python 3 e gcc), não faz parte do firmware
+#
+# Descrição:
+# Compila módulos do firmware no PC e roda contra eles os testes
+# <modulo>_teste.c desta pasta. O gcc não tem os tamanhos de tipo do mikroC
+# (int de 16 bits, short de 8), então os fontes são copiados para uma pasta
+# temporária com os tipos trocados pelos de largura fixa:
+#
+#   mikroC            PC
+#   long              int32_t       (unsigned long: uint32_t)
+#   int               int16_t       (unsigned int: uint16_t)
+#   short             int8_t        (unsigned short: uint8_t)
+#   char              unsigned char (-funsigned-char)
+#
+# e o "asm MULWF PRODL, 0" vira uma chamada que faz PRODH:PRODL = WREG *
+# PRODL, como o multiplicador do PIC18. Cada fonte x.c vira x_host.c, que o
+# teste inclui depois de declarar os substitutos do hardware (registradores,
+# bibliotecas do mikroC, módulos vizinhos). Conta com sinal que passa de 32
+# bits dá a volta (-fwrapv), como no long do mikroC. O resto do código é o
+# mesmo que vai para o PIC. O teste em si não é traduzido: nele int é o do
+# PC e os tipos do firmware aparecem como stdint.
+#
+# Compila com -Wall -Wextra -Wconversion -Werror: corte de valor que o gcc
+# aponta no fonte traduzido para o teste; onde o corte é de propósito o
+# firmware tem o cast explícito. Os avisos desligados estão em AVISOS, cada
+# um com o motivo.
+#
+#   Teste         Perfis (config.h)
+#   bme280        USE_MUL_8X8 = 1 e 0
+#   adaptativo    padrão
+#   vario         USE_DISPLAY = 1
+#   cmd           USE_DISPLAY = 1
+#   lcd_fb        USE_DISPLAY = 1
+#
+# Sai com código 1 se algum teste falhar.
+#
+# Uso: python3 teste_host.py [teste ...]    (sem nomes roda todos)
+###############################################################################
+
+import glob
+import os
+import re
+import shutil
+import subprocess
+import sys
+import tempfile
+
+PASTA = os.path.dirname(os.path.abspath(__file__))
+
+# Teste e perfis de config.h em que ele roda
+TESTES = [
+    ('bme280', [{'USE_MUL_8X8': 1}, {'USE_MUL_8X8': 0}]),
+    ('adaptativo', [{}]),
+    ('vario', [{'USE_DISPLAY': 1}]),
+    ('cmd', [{'USE_DISPLAY': 1}]),
+    ('lcd_fb', [{'USE_DISPLAY': 1}]),
+]
+
+TIPOS = [
+    (r'\bunsigned\s+long\b', 'uint32_t'),
+    (r'\blong\b', 'int32_t'),
+    (r'\bunsigned\s+int\b', 'uint16_t'),
+    (r'\bint\b', 'int16_t'),
+    (r'\bunsigned\s+short\b', 'uint8_t'),
+    (r'\bshort\b', 'int8_t'),
+]
+
+AVISOS = [
+    '-Wno-unused-parameter',                                                    # Substitutos ignoram argumentos
+    '-Wno-sign-conversion',                                                     # Com e sem sinal se misturam de propósito (fórmula da Bosch)
+]
+
+
+# Copia um fonte do firmware com os tipos do mikroC (latin-1 preserva os bytes)
+def traduz(caminho, destino, perfil):
+    nome = os.path.basename(caminho)
+    with open(caminho, encoding='latin-1') as f:
+        s = f.read()
+
+    s = s.replace('asm MULWF PRODL, 0', 'TST_Mulwf()')
+    for de, para in TIPOS:
+        s = re.sub(de, para, s)
+    if nome == 'config.h':
+        for flag, valor in perfil.items():
+            s = re.sub(r'(#define %s\s+)\d+' % flag, r'\g<1>%d' % valor, s)
+    if nome.endswith('.c'):
+        nome = nome[:-2] + '_host.c'                                            # Não colide com o original no include
+
+    with open(os.path.join(destino, nome), 'w', encoding='latin-1') as f:
+        f.write(s)
+
+
+def roda(teste, perfil):
+    pasta = tempfile.mkdtemp(prefix='teste_host_')
+    try:
+        for caminho in glob.glob(os.path.join(PASTA, '*.[ch]')):
+            if not caminho.endswith('_teste.c'):
+                traduz(caminho, pasta, perfil)
+        fonte = os.path.join(pasta, teste + '_teste.c')
+        shutil.copy(os.path.join(PASTA, teste + '_teste.c'), fonte)
+
+        exe = os.path.join(pasta, 'teste')
+        cc = ['gcc', '-O2', '-std=gnu99', '-Wall', '-Wextra', '-Wconversion', '-Werror',
+              '-fwrapv', '-funsigned-char'] + AVISOS + ['-o', exe, fonte, '-lm']
+        nome = ' '.join('%s = %d' % p for p in perfil.items())
+        print('== %s%s' % (teste, ' (%s)' % nome if nome else ''), flush=True)
+        if subprocess.call(cc):
+            return False
+        return subprocess.call([exe]) == 0
+    finally:
+        shutil.rmtree(pasta)
+
+
+pedidos = sys.argv[1:]
+ok = True
+for teste, perfis in TESTES:
+    if pedidos and teste not in pedidos:
+        continue
+    for perfil in perfis:
+        ok = roda(teste, perfil) and ok
+
+sys.exit(0 if ok else 1)
@@ -0,0 +1,220 @@
+/******************************************************************************
+ * Biblioteca: Unidades de exibição (unidades.c)
+ * Autor: Elison Nogueira
+ * Data: 18/10/2026
+ * Versão: 1.0
+ * Plataforma: PIC18F25K50 (Microchip)
+ * Compilador: mikroC Pro for PIC v7.6.0
+ *
+ * Descrição:
+ * Conversões por multiplicação e deslocamento e formatação sem divisão.
+ * Veja unidades.h.
+ ******************************************************************************/
+
+#include "unidades.h"
+
+#define UN_TAB_INICIO     (-4096)                                               // -40.96°C (c°C)
+#define UN_TAB_PASSO      8                                                     // 2^8 = 256 c°C por intervalo
+#define UN_TAB_QTD        51
+
+// Constantes de conversão por unidade (veja a tabela em unidades.h)
+const unsigned int un_t_mult[UN_T_QTD] = {1, 14746, 1};
+const unsigned char un_t_desl[UN_T_QTD] = {0, 13, 0};
+const long un_t_offset[UN_T_QTD] = {0, 3200, 27315};
+const unsigned int un_p_mult[UN_P_QTD] = {1, 30964, 24578};
+const unsigned char un_p_desl[UN_P_QTD] = {0, 20, 15};
+
+// Densidade de vapor saturado * 10.24 (cg/m³), de -40.96°C a 87.04°C em passos de 2.56°C
+// (gerada por unidades_erros.py)
+const unsigned long un_rho[UN_TAB_QTD] = {
+    164, 212, 272, 346, 438, 550, 689, 857, 1061, 1308,
+    1603, 1957, 2377, 2875, 3464, 4155, 4965, 5911, 7010, 8284,
+    9755, 11449, 13394, 15619, 18158, 21047, 24324, 28033, 32218, 36930,
+    42222, 48151, 54777, 62168, 70392, 79524, 89644, 100835, 113188, 126796,
+    141759, 158182, 176176, 195858, 217350, 240780, 266281, 293994, 324066, 356649,
+    391901
+};
+
+const unsigned long un_pot10[7] = {1000000, 100000, 10000, 1000, 100, 10, 1};
+
+unsigned char un_temp, un_pres, un_umid;                                        // Unidades selecionadas
+
+// Constantes copiadas da unidade atual (evita indexar a cada conversão)
+unsigned long un_tm, un_tr, un_pm, un_pr;                                       // Multiplicador e arredondamento
+unsigned char un_td, un_pd;                                                     // Deslocamentos
+long un_to;                                                                     // Offset da temperatura
+
+// Troca as unidades e recalcula as constantes de conversão
+void UN_Select(unsigned char temp, unsigned char pres, unsigned char umid) {
+    un_temp = temp < UN_T_QTD ? temp : UN_CELSIUS;
+    un_pres = pres < UN_P_QTD ? pres : UN_HPA;
+    un_umid = umid < UN_H_QTD ? umid : UN_RELATIVA;
+
+    un_tm = un_t_mult[un_temp];
+    un_td = un_t_desl[un_temp];
+    un_tr = un_td ? 1UL << (un_td - 1) : 0;
+    un_to = un_t_offset[un_temp];
+
+    un_pm = un_p_mult[un_pres];
+    un_pd = un_p_desl[un_pres];
+    un_pr = un_pd ? 1UL << (un_pd - 1) : 0;
+}
+
+// Converte c°C para centésimos da unidade de temperatura
+long UN_Temp(long temp) {
+    unsigned long m;
+
+    m = temp < 0 ? -temp : temp;                                                // Desloca a magnitude (arredonda simétrico)
+    m = (m * un_tm + un_tr) >> un_td;
+
+    return (temp < 0 ? -(long)m : (long)m) + un_to;
+}
+
+// Converte Pa para centésimos da unidade de pressão
+unsigned long UN_Pres(unsigned long pres) {
+    return (pres * un_pm + un_pr) >> un_pd;                                     // 110000 * 30964 < 2^32
+}
+
+// Converte a umidade para centésimos de % UR ou de g/m³
+unsigned long UN_Umid(long temp, unsigned long humi) {
+    unsigned long rho;
+    unsigned int frac;
+    unsigned char i;
+
+    if(un_umid == UN_RELATIVA)
+        return (humi * 25 + 128) >> 8;                                          // 100/1024 = 25/256
+
+    // Índice e fração dentro do intervalo de 2.56°C
+    temp -= UN_TAB_INICIO;
+    if(temp < 0) temp = 0;
+    i = (unsigned char)(temp >> UN_TAB_PASSO);
+    if(i >= UN_TAB_QTD - 1) {
+        i = UN_TAB_QTD - 2;
+        frac = 1 << UN_TAB_PASSO;                                               // Satura no fim da tabela
+    } else {
+        frac = (unsigned int)temp & ((1 << UN_TAB_PASSO) - 1);
+    }
+
+    rho = un_rho[i] + (((un_rho[i + 1] - un_rho[i]) * frac) >> UN_TAB_PASSO);
+
+    return (rho * (humi >> 4) + 32768) >> 16;                                   // 391904 * 6400 < 2^32
+}
+
+// Escreve os 7 dígitos decimais de valor (< 10^7) por subtrações sucessivas
+static void UN_Digits(char *d, unsigned long valor) {
+    unsigned char i;
+    char c;
+
+    for(i = 0; i < 7; i++) {
+        c = '0';
+        while(valor >= un_pot10[i]) {
+            valor -= un_pot10[i];
+            c++;
+        }
+        d[i] = c;
+    }
+}
+
+// Formata centésimos com 1 ou 2 casas decimais (1 casa arredonda)
+unsigned char UN_FmtDec(char *s, long centi, unsigned char decimais) {
+    char d[7];
+    unsigned char i, n;
+    unsigned long m;
+
+    n = 0;
+    if(centi < 0) {
+        s[n++] = '-';
+        m = -centi;
+    } else {
+        m = centi;
+    }
+    if(decimais == 1)
+        m += 5;
+
+    UN_Digits(d, m);
+
+    for(i = 0; i < 4 && d[i] == '0'; i++);                                      // Pula zeros à esquerda (mantém as unidades)
+    for(; i < 5; i++)
+        s[n++] = d[i];
+    s[n++] = '.';
+    s[n++] = d[5];
+    if(decimais == 2)
+        s[n++] = d[6];
+    s[n] = 0;
+
+    return n;
+}
+
+// Formata um inteiro sem sinal (< 10^7)
+unsigned char UN_FmtUInt(char *s, unsigned long valor) {
+    char d[7];
+    unsigned char i, n;
+
+    UN_Digits(d, valor);
+
+    n = 0;
+    for(i = 0; i < 6 && d[i] == '0'; i++);
+    for(; i < 7; i++)
+        s[n++] = d[i];
+    s[n] = 0;
+
+    return n;
+}
+
+// Formata um byte em dois dígitos hexadecimais
+unsigned char UN_FmtHex(char *s, unsigned char valor) {
+    unsigned char nib;
+
+    nib = valor >> 4;
+    s[0] = nib < 10 ? '0' + nib : 'A' - 10 + nib;
+    nib = valor & 0x0F;
+    s[1] = nib < 10 ? '0' + nib : 'A' - 10 + nib;
+    s[2] = 0;
+
+    return 2;
+}
+
+// Acrescenta um texto ao fim de s; retorna o novo tamanho
+unsigned char UN_Cat(char *s, const char *sufixo) {
+    unsigned char n;
+
+    for(n = 0; s[n]; n++);
+    while(*sufixo)
+        s[n++] = *sufixo++;
+    s[n] = 0;
+
+    return n;
+}
+
+// Formata a temperatura convertida com o símbolo da unidade
+unsigned char UN_FmtTemp(char *s, long valor) {
+    UN_FmtDec(s, valor, 2);
+
+    switch(un_temp) {
+        case UN_FAHRENHEIT: return UN_Cat(s, "F");
+        case UN_KELVIN:     return UN_Cat(s, "K");
+        default:            return UN_Cat(s, "C");
+    }
+}
+
+// Formata a pressão convertida com o símbolo da unidade
+unsigned char UN_FmtPres(char *s, unsigned long valor) {
+    UN_FmtDec(s, valor, 2);
+
+    switch(un_pres) {
+        case UN_INHG: return UN_Cat(s, "inHg");
+        case UN_MMHG: return UN_Cat(s, "mmHg");
+        default:      return UN_Cat(s, "hPa");
+    }
+}
+
+// Formata a umidade convertida com o símbolo da unidade
+unsigned char UN_FmtUmid(char *s, unsigned long valor) {
+    if(un_umid == UN_ABSOLUTA) {
+        UN_FmtDec(s, valor, 1);
+        return UN_Cat(s, "g/m3");
+    }
+
+    UN_FmtDec(s, valor, 2);
+    return UN_Cat(s, "%");
+}
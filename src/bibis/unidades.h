@@ -0,0 +1,77 @@
+/******************************************************************************
+ * Biblioteca: Unidades de exibição (unidades.h)
+ * Autor: Elison Nogueira
+ * Data: 18/10/2026
+ * Versão: 1.0
+ * Plataforma: PIC18F25K50 (Microchip)
+ * Compilador: mikroC Pro for PIC v7.6.0
+ *
+ * Descrição:
+ * Conversão das leituras para a unidade escolhida e formatação decimal,
+ * sem divisão nem ponto flutuante no caminho de atualização do display.
+ *
+ * Temperatura e pressão são convertidas por y = ((x * mult + r) >> desl) +
+ * offset, com as constantes da unidade copiadas em UN_Select (só na troca
+ * de unidade). Todos os resultados são centésimos da unidade escolhida:
+ *
+ *   Unidade  mult / 2^desl             Exata       offset   Erro máx.
+ *   °C       1                         1           0        -
+ *   °F       14746 / 2^13 = 1.800049   1.8         3200     0.8 c°F
+ *   K        1                         1           27315    -
+ *   hPa      1 (Pa = c hPa)            1           0        -
+ *   inHg     30964 / 2^20 = 0.029530   0.02952998  0        0.5 c inHg
+ *   mmHg     24578 / 2^15 = 0.750061   0.7500616   0        0.6 c mmHg
+ *
+ * O erro máximo já inclui o arredondamento para centésimos. A tabela sai de
+ * unidades_erros.py, que refaz as contas inteiras em todo c°C de -40°C a
+ * 85°C e todo Pa de 300 a 1100 hPa.
+ *
+ * Umidade relativa: c% = (H * 25 + 128) >> 8, sem erro de constante.
+ * Umidade absoluta: g/m³ = UR * rho_sat(T). rho_sat vem de uma tabela a cada
+ * 2.56°C de -40.96°C a 87.04°C (fórmula de Magnus), com interpolação linear
+ * por deslocamento. A tabela guarda rho_sat * 10.24 em cg/m³, de modo que
+ * cg/m³ = (rho' * (H >> 4)) >> 16. Erro relativo de até 1.53% acima de
+ * 0.5 g/m³ (unidades_erros.py, em toda a faixa de T e UR), já incluindo o
+ * arredondamento, dentro da precisão do sensor (±3% UR).
+ *
+ * Os formatadores usam subtrações sucessivas de potências de 10 em vez de
+ * sprintf e retornam o número de caracteres escritos.
+ *****************************************************************************/
+
+#ifndef UNIDADES_H
+#define UNIDADES_H
+
+// Unidades de temperatura
+#define UN_CELSIUS        0
+#define UN_FAHRENHEIT     1
+#define UN_KELVIN         2
+#define UN_T_QTD          3
+
+// Unidades de pressão
+#define UN_HPA            0
+#define UN_INHG           1
+#define UN_MMHG           2
+#define UN_P_QTD          3
+
+// Unidades de umidade
+#define UN_RELATIVA       0                                                     // % UR
+#define UN_ABSOLUTA       1                                                     // g/m³
+#define UN_H_QTD          2
+
+// Unidades selecionadas
+extern unsigned char un_temp, un_pres, un_umid;
+
+// Protótipos das funções
+void UN_Select(unsigned char temp, unsigned char pres, unsigned char umid);     // Troca as unidades e as constantes
+long UN_Temp(long temp);                                                        // c°C -> centésimos da unidade
+unsigned long UN_Pres(unsigned long pres);                                      // Pa -> centésimos da unidade
+unsigned long UN_Umid(long temp, unsigned long humi);                           // 1/1024 % -> centésimos da unidade
+unsigned char UN_FmtTemp(char *s, long valor);                                  // Valor convertido + símbolo
+unsigned char UN_FmtPres(char *s, unsigned long valor);                         // Valor convertido + símbolo
+unsigned char UN_FmtUmid(char *s, unsigned long valor);                         // Valor convertido + símbolo
+unsigned char UN_FmtDec(char *s, long centi, unsigned char decimais);           // Centésimos com 1 ou 2 decimais
+unsigned char UN_FmtUInt(char *s, unsigned long valor);                         // Inteiro sem sinal
+unsigned char UN_FmtHex(char *s, unsigned char valor);                          // Dois dígitos hexadecimais
+unsigned char UN_Cat(char *s, const char *sufixo);                              // Acrescenta texto; retorna o tamanho total
+
+#endif
@@ -0,0 +1,147 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+###############################################################################
+# Ferramenta: Erro das conversões de unidade (unidades_erros.py)
+# Autor: Elison Nogueira
+# Data: 18/10/2026
+# Versão: 1.0
+# Plataforma: PC (Python 3), não faz parte do firmware
+#
+# Descrição:
+# Refaz no PC, com as mesmas contas inteiras de unidades.c, cada conversão
+# para todos os valores que o sensor entrega na faixa de operação e compara
+# com o valor exato. Imprime a tabela de constantes e erros do comentário de
+# unidades.h e a tabela un_rho de unidades.c; rode de novo se uma constante
+# mudar.
+#
+# Entradas (datasheet BME280, tabela 1):
+# - Temperatura: todo c°C de -40°C a 85°C
+# - Pressão: todo Pa de 300 a 1100 hPa
+# - Umidade: todo passo de 1/1024 % de 0 a 100%, em cada c°C da faixa
+#   (umidade absoluta)
+#
+# O erro é |resultado - exato| em centésimos da unidade e já inclui o
+# arredondamento do resultado. A constante de cada unidade é o mult mais
+# próximo de fator * 2^desl; o desl é o maior em que x * mult + r cabe em
+# 32 bits no maior valor da faixa.
+#
+# Umidade absoluta: densidade de vapor saturado pela fórmula de Magnus,
+#   e_s = 6.112 * exp(17.62 * t / (243.12 + t))   hPa
+#   rho = 216.7 * e_s / (273.15 + t)              g/m³
+# guardada * 10.24 em cg/m³ (* 1024 em g/m³), de -40.96°C em passos de
+# 2.56°C. O erro relativo é o maior acima de RHO_MIN g/m³.
+#
+# Leva cerca de um minuto e meio (a umidade absoluta varre T x UR).
+#
+# Uso: python3 unidades_erros.py
+###############################################################################
+
+import math
+
+T_MIN, T_MAX = -4000, 8500                                                      # c°C
+P_MIN, P_MAX = 30000, 110000                                                    # Pa
+H_MAX = 102400                                                                  # 100% em 1/1024 %
+RHO_MIN = 0.5                                                                   # g/m³
+
+TAB_INICIO = -4096                                                              # c°C
+TAB_PASSO = 8                                                                   # 2^8 c°C por intervalo
+TAB_QTD = 51
+
+# Unidade, fator exato (centésimos da unidade por c°C ou por Pa), offset, desl de unidades.c
+TEMPERATURA = [('°C', 1.0, 0, 0), ('°F', 1.8, 3200, 13), ('K', 1.0, 27315, 0)]
+PRESSAO = [('hPa', 1.0, 0, 0), ('inHg', 100 / 3386.389, 0, 20), ('mmHg', 100 / 133.322387, 0, 15)]
+
+
+def constante(fator, desl):
+    return round(fator * (1 << desl))
+
+
+# UN_Temp: desloca a magnitude e devolve o sinal (arredondamento simétrico)
+def temp(x, mult, desl, offset):
+    r = (1 << (desl - 1)) if desl else 0
+    m = (abs(x) * mult + r) >> desl
+    return (-m if x < 0 else m) + offset
+
+
+# UN_Pres
+def pres(x, mult, desl):
+    r = (1 << (desl - 1)) if desl else 0
+    return (x * mult + r) >> desl
+
+
+def rho_sat(t):
+    e = 6.112 * math.exp(17.62 * t / (243.12 + t))
+    return 216.7 * e / (273.15 + t)
+
+
+def tabela():
+    return [round(rho_sat((TAB_INICIO + (i << TAB_PASSO)) / 100) * 1024) for i in range(TAB_QTD)]
+
+
+# UN_Umid (umidade absoluta), em cg/m³
+def absoluta(tab, t, h):
+    t -= TAB_INICIO
+    if t < 0:
+        t = 0
+    i = t >> TAB_PASSO
+    if i >= TAB_QTD - 1:
+        i = TAB_QTD - 2
+        frac = 1 << TAB_PASSO
+    else:
+        frac = t & ((1 << TAB_PASSO) - 1)
+    rho = tab[i] + (((tab[i + 1] - tab[i]) * frac) >> TAB_PASSO)
+    assert rho * (h >> 4) < 1 << 32
+    return (rho * (h >> 4) + 32768) >> 16
+
+
+# Linha da tabela de unidades.h
+def linha(nome, fator, offset, desl, pior):
+    if desl:
+        mult = constante(fator, desl)
+        razao = '%d / 2^%d = %.6f' % (mult, desl, mult / (1 << desl))
+        exata = '%.7g' % fator
+    else:
+        razao = '1 (Pa = c hPa)' if nome == 'hPa' else '1'
+        exata = '1'
+    erro = '%.1f c%s%s' % (pior, ' ' if len(nome) > 2 else '', nome) if desl else '-'
+    print('//   %-8s %-25s %-11s %-8d %s' % (nome, razao, exata, offset, erro))
+
+
+print('//   %-8s %-25s %-11s %-8s %s' % ('Unidade', 'mult / 2^desl', 'Exata', 'offset', 'Erro máx.'))
+
+for nome, fator, offset, desl in TEMPERATURA:
+    mult = constante(fator, desl)
+    assert max(-T_MIN, T_MAX) * mult + (1 << desl) < 1 << 32                  # Cabe em unsigned long
+    pior = max(abs(temp(x, mult, desl, offset) - (x * fator + offset)) for x in range(T_MIN, T_MAX + 1))
+    linha(nome, fator, offset, desl, pior)
+
+for nome, fator, offset, desl in PRESSAO:
+    mult = constante(fator, desl)
+    assert P_MAX * mult + (1 << desl) < 1 << 32                                # Cabe em unsigned long
+    pior = max(abs(pres(x, mult, desl) - x * fator) for x in range(P_MIN, P_MAX + 1))
+    linha(nome, fator, offset, desl, pior)
+
+# Umidade relativa: c% = (H * 25 + 128) >> 8
+pior = max(abs(((h * 25 + 128) >> 8) - h * 100 / 1024) for h in range(H_MAX + 1))
+print('\n// UR: erro máx. %.2f c%% (só o arredondamento)' % pior)
+
+# Umidade absoluta
+tab = tabela()
+pior = 0
+for t in range(T_MIN, T_MAX + 1):
+    rho = rho_sat(t / 100)
+    for h in range(0, H_MAX + 1, 16):                                          # Passo do H >> 4 de UN_Umid
+        exato = rho * h / 102400                                                # g/m³
+        if exato < RHO_MIN:
+            continue
+        erro = abs(absoluta(tab, t, h) / 100 - exato) / exato
+        if erro > pior:
+            pior, onde = erro, (t, h)
+print('// g/m³: erro relativo máx. %.2f%% acima de %.1f g/m³ (em %.2f°C, %.1f%% UR)'
+      % (pior * 100, RHO_MIN, onde[0] / 100, onde[1] / 1024))
+
+print('\nconst unsigned long un_rho[UN_TAB_QTD] = {')
+for i in range(0, TAB_QTD, 10):
+    fim = ',' if i + 10 < TAB_QTD else ''
+    print('    ' + ', '.join(str(v) for v in tab[i:i + 10]) + fim)
+print('};')
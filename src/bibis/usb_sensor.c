@@ -0,0 +1,126 @@
+/******************************************************************************
+ * Biblioteca: Sensor USB HID (usb_sensor.c)
+ * Autor: Elison Nogueira
+ * Data: 18/10/2026
+ * Versão: 1.0
+ * Plataforma: PIC18F25K50 (Microchip)
+ * Compilador: mikroC Pro for PIC v7.6.0
+ *
+ * Descrição:
+ * Publica as leituras do BME280 como um dispositivo USB HID da classe de
+ * sensores. Veja usb_sensor.h e o descritor de relatório em USBdsc.c.
+ *
+ * Dependências:
+ * - Biblioteca USB HID do mikroC PRO for PIC
+ * - Descritores em USBdsc.c
+ ******************************************************************************/
+
+#include "config.h"
+#include "usb_sensor.h"
+
+#if USE_USB_HID
+
+// Buffers do HID na RAM dual-port do USB (0x400..0x7FF)
+unsigned char hids_readbuff[64] absolute 0x500;                                 // Buffer de recepção (OUT)
+unsigned char hids_writebuff[64] absolute 0x540;                                // Buffer de transmissão (IN)
+
+// Imagens prontas dos relatórios de entrada
+unsigned char hids_rpt_temp[HIDS_TAM_TEMPERATURA];                              // Relatório de temperatura
+unsigned char hids_rpt_umid[HIDS_TAM_UMIDADE];                                  // Relatório de umidade
+unsigned char hids_rpt_pres[HIDS_TAM_PRESSAO];                                  // Relatório de pressão
+
+unsigned char hids_pendentes;                                                   // Bits 0..2: relatórios a enviar
+
+// Copia um relatório para o buffer de transmissão e tenta enviá-lo
+static unsigned char HIDS_Send(unsigned char *rpt, unsigned char len) {
+    unsigned char i;
+
+    for(i = 0; i < len; i++)
+        hids_writebuff[i] = rpt[i];                                             // Copia imagem já formatada
+
+    return HID_Write(&hids_writebuff, len);                                     // 0 = endpoint ocupado
+}
+
+// Grava o timestamp da amostra (uint32 little-endian) no relatório
+static void HIDS_PutTs(unsigned char *dst, unsigned long ts) {
+    dst[0] = Lo(ts);
+    dst[1] = Hi(ts);
+    dst[2] = Higher(ts);
+    dst[3] = Highest(ts);
+}
+
+// Habilita o HID e monta o cabeçalho fixo dos relatórios
+void HIDS_Init(void) {
+    hids_rpt_temp[0] = HIDS_ID_TEMPERATURA;                                     // Report ID
+    hids_rpt_umid[0] = HIDS_ID_UMIDADE;
+    hids_rpt_pres[0] = HIDS_ID_PRESSAO;
+
+    hids_rpt_temp[1] = HIDS_ESTADO_NO_DATA;                                     // Sem dados até a primeira amostra
+    hids_rpt_umid[1] = HIDS_ESTADO_NO_DATA;
+    hids_rpt_pres[1] = HIDS_ESTADO_NO_DATA;
+
+    hids_rpt_temp[2] = HIDS_EVENTO_DATA;                                        // Todo envio é de dados novos
+    hids_rpt_umid[2] = HIDS_EVENTO_DATA;
+    hids_rpt_pres[2] = HIDS_EVENTO_DATA;
+
+    hids_pendentes = 0;
+
+    HID_Enable(&hids_readbuff, &hids_writebuff);                                // Inicia enumeração
+}
+
+// Atualiza os campos de valor com a última amostra (sem formatação)
+void HIDS_Publish(amostra_bme280 *a) {
+    long temp;
+    unsigned long pres;
+    unsigned int umid_centi;
+
+    temp = a->temperatura;                                                      // Lo/Hi exigem variáveis escalares
+    pres = a->pressao;
+    umid_centi = (unsigned int)((a->umidade * 25) >> 8);                        // 1/1024 % -> 1/100 %
+
+    hids_rpt_temp[1] = HIDS_ESTADO_READY;
+    hids_rpt_temp[3] = Lo(temp);                                                // int16 little-endian
+    hids_rpt_temp[4] = Hi(temp);
+    HIDS_PutTs(hids_rpt_temp + 5, a->ts);
+
+    hids_rpt_umid[1] = HIDS_ESTADO_READY;
+    hids_rpt_umid[3] = Lo(umid_centi);                                          // uint16 little-endian
+    hids_rpt_umid[4] = Hi(umid_centi);
+    HIDS_PutTs(hids_rpt_umid + 5, a->ts);
+
+    hids_rpt_pres[1] = HIDS_ESTADO_READY;
+    hids_rpt_pres[3] = Lo(pres);                                                // uint32 little-endian
+    hids_rpt_pres[4] = Hi(pres);
+    hids_rpt_pres[5] = Higher(pres);
+    hids_rpt_pres[6] = Highest(pres);
+    HIDS_PutTs(hids_rpt_pres + 7, a->ts);
+
+    hids_pendentes = 0x07;                                                      // Os três relatórios mudaram
+}
+
+// Sinaliza erro do sensor nos três relatórios, mantendo os últimos valores
+void HIDS_Fault(void) {
+    hids_rpt_temp[1] = HIDS_ESTADO_ERROR;
+    hids_rpt_umid[1] = HIDS_ESTADO_ERROR;
+    hids_rpt_pres[1] = HIDS_ESTADO_ERROR;
+
+    hids_pendentes = 0x07;
+}
+
+// Envia os relatórios pendentes; retorna sem esperar se o endpoint estiver ocupado
+void HIDS_Task(void) {
+    if(hids_pendentes & 0x01) {
+        if(!HIDS_Send(hids_rpt_temp, HIDS_TAM_TEMPERATURA)) return;
+        hids_pendentes &= ~0x01;
+    }
+    if(hids_pendentes & 0x02) {
+        if(!HIDS_Send(hids_rpt_umid, HIDS_TAM_UMIDADE)) return;
+        hids_pendentes &= ~0x02;
+    }
+    if(hids_pendentes & 0x04) {
+        if(!HIDS_Send(hids_rpt_pres, HIDS_TAM_PRESSAO)) return;
+        hids_pendentes &= ~0x04;
+    }
+}
+
+#endif
@@ -0,0 +1,56 @@
+/******************************************************************************
+ * Biblioteca: Sensor USB HID (usb_sensor.h)
+ * Autor: Elison Nogueira
+ * Data: 18/10/2026
+ * Versão: 1.0
+ * Plataforma: PIC18F25K50 (Microchip)
+ * Compilador: mikroC Pro for PIC v7.6.0
+ *
+ * Descrição:
+ * Publica as leituras do BME280 como um dispositivo USB HID da classe de
+ * sensores (HID Sensor Usages, página 0x20). São expostos três sensores
+ * ambientais, cada um em sua coleção com Report ID próprio:
+ * - Report ID 1: temperatura em centésimos de °C (expoente -2)
+ * - Report ID 2: umidade relativa em centésimos de % (expoente -2)
+ * - Report ID 3: pressão atmosférica em Pa (bar, expoente -5)
+ * Cada relatório termina com o timestamp RTC da amostra (veja rtc.h).
+ *
+ * Os relatórios ficam montados em RAM desde a inicialização. A cada amostra
+ * apenas os campos de valor são atualizados, sem formatação por relatório, e
+ * o envio é feito pelo endpoint de interrupção quando o host faz polling.
+ *
+ * Dependências:
+ * - Biblioteca USB HID do mikroC PRO for PIC
+ * - Descritores em USBdsc.c
+ *****************************************************************************/
+
+#ifndef USB_SENSOR_H
+#define USB_SENSOR_H
+
+#include "historico.h"
+
+// Report IDs dos sensores
+#define HIDS_ID_TEMPERATURA   1                                                 // Sensor de temperatura
+#define HIDS_ID_UMIDADE       2                                                 // Sensor de umidade
+#define HIDS_ID_PRESSAO       3                                                 // Sensor de pressão
+
+// Tamanho de cada relatório de entrada (incluindo Report ID)
+#define HIDS_TAM_TEMPERATURA  9                                                 // ID + estado + evento + int16 + ts
+#define HIDS_TAM_UMIDADE      9                                                 // ID + estado + evento + uint16 + ts
+#define HIDS_TAM_PRESSAO     11                                                 // ID + estado + evento + uint32 + ts
+
+// Estados do sensor (índices da seleção Sensor State 0x0800..0x0806)
+#define HIDS_ESTADO_READY     1                                                 // Sensor pronto
+#define HIDS_ESTADO_NO_DATA   3                                                 // Sem dados
+#define HIDS_ESTADO_ERROR     6                                                 // Erro
+
+// Eventos do sensor (índices da seleção Sensor Event 0x0810..0x0815)
+#define HIDS_EVENTO_DATA      3                                                 // Dados atualizados
+
+// Protótipos das funções
+void HIDS_Init(void);                                                           // Habilita o HID e monta os relatórios
+void HIDS_Publish(amostra_bme280 *a);                                           // Atualiza os relatórios com a última amostra
+void HIDS_Fault(void);                                                          // Sinaliza erro do sensor ao host
+void HIDS_Task(void);                                                           // Envia relatórios pendentes sem bloquear
+
+#endif
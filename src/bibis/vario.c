@@ -0,0 +1,136 @@
+/******************************************************************************
+ * Biblioteca: Variômetro (vario.c)
+ * Autor: Elison Nogueira
+ * Data: 18/10/2026
+ * Versão: 1.0
+ * Plataforma: PIC18F25K50 (Microchip)
+ * Compilador: mikroC Pro for PIC v7.6.0
+ *
+ * Descrição:
+ * Altitude por tabela e filtro alfa-beta em ponto fixo. Veja vario.h.
+ ******************************************************************************/
+
+#include "config.h"
+#include "vario.h"
+#include "bme280.h"
+
+#if USE_DISPLAY
+
+#define VAR_TAB_INICIO    30000                                                 // Pressão da primeira entrada (Pa)
+#define VAR_TAB_PASSO     10                                                    // 2^10 = 1024 Pa por intervalo
+#define VAR_TAB_QTD       80
+#define VAR_FRACAO        4                                                     // Bits de fração de h e v
+
+// Altitude padrão (cm) para p = 30000 + 1024*i Pa
+const long var_altitude[VAR_TAB_QTD] = {
+    916516, 893984, 872047, 850670, 829822, 809476, 789604, 770183,
+    751190, 732606, 714410, 696586, 679116, 661985, 645179, 628685,
+    612489, 596581, 580948, 565580, 550469, 535603, 520975, 506575,
+    492398, 478433, 464676, 451119, 437755, 424578, 411584, 398766,
+    386118, 373637, 361317, 349154, 337142, 325279, 313560, 301981,
+    290538, 279228, 268048, 256994, 246064, 235253, 224560, 213980,
+    203513, 193155, 182903, 172755, 162709, 152763, 142914, 133161,
+    123500, 113931, 104452, 95060, 85753, 76531, 67391, 58331,
+    49351, 40448, 31622, 22870, 14191, 5585, -2951, -11418,
+    -19817, -28148, -36415, -44616, -52754, -60830, -68844, -76799
+};
+
+config_bme280 var_anterior;                                                     // Configuração a restaurar
+unsigned char var_ativo;                                                        // 1 = modo variômetro
+unsigned char var_primeira;                                                     // 1 = filtro ainda não iniciado
+unsigned char var_contador;                                                     // Amostras até o próximo redesenho
+long var_h, var_v;                                                              // Estado do filtro (Q4)
+
+// Desloca à direita preservando o sinal (arredonda em direção a zero)
+static long VAR_Shr(long x, unsigned char n) {
+    return x < 0 ? -((-x) >> n) : x >> n;
+}
+
+// Converte pressão (Pa) em altitude padrão (cm)
+static long VAR_PressureToAltitude(unsigned long pres) {
+    unsigned long d;
+    unsigned int frac;
+    unsigned char i;
+
+    if(pres < VAR_TAB_INICIO)
+        pres = VAR_TAB_INICIO;
+    d = pres - VAR_TAB_INICIO;
+    i = (unsigned char)(d >> VAR_TAB_PASSO);
+    if(i >= VAR_TAB_QTD - 1) {
+        i = VAR_TAB_QTD - 2;
+        frac = 1 << VAR_TAB_PASSO;                                              // Satura no fim da tabela
+    } else {
+        frac = (unsigned int)d & ((1 << VAR_TAB_PASSO) - 1);
+    }
+
+    // A tabela é decrescente: subtrai a parcela do intervalo (sempre positiva)
+    return var_altitude[i] -
+           (long)(((unsigned long)(var_altitude[i] - var_altitude[i + 1]) * frac) >> VAR_TAB_PASSO);
+}
+
+// Entra no modo variômetro com a configuração de alta taxa
+void VAR_Start(void) {
+    var_anterior = BME280_cfg;
+
+    BME280_Configure(MODE_NORMAL, SAMPLING_X1, SAMPLING_X1, SAMPLING_X8,
+                     FILTER_4, STANDBY_0_5);
+
+    var_ativo = 1;
+    var_primeira = 1;
+    var_contador = VAR_DISPLAY;
+    var_h = 0;
+    var_v = 0;
+}
+
+// Sai do modo variômetro e restaura a configuração anterior
+void VAR_Stop(void) {
+    BME280_Configure(var_anterior.mode, var_anterior.T_sampling,
+                     var_anterior.H_sampling, var_anterior.P_sampling,
+                     var_anterior.filter, var_anterior.standby);
+    var_ativo = 0;
+}
+
+// Retorna 1 enquanto o modo variômetro estiver ativo
+unsigned char VAR_Active(void) {
+    return var_ativo;
+}
+
+// Lê a pressão, atualiza o filtro; retorna 1 quando é hora de redesenhar
+unsigned char VAR_Sample(void) {
+    long z, r;
+    unsigned long pres;
+
+    BME280_MarkConversion();                                                    // VAR_PERIODO é maior que o ciclo do sensor
+    BME280_Update();
+    ReadPressure(&pres);                                                        // Compensa t_fine e pressão; umidade fica suja
+
+    z = VAR_PressureToAltitude(pres) << VAR_FRACAO;
+
+    if(var_primeira) {                                                          // Inicia na primeira medida, parado
+        var_primeira = 0;
+        var_h = z;
+        var_v = 0;
+    } else {
+        var_h += VAR_Shr(var_v, 4);                                             // h' = h + v*dt (dt = 1/16 s)
+        r = z - var_h;
+        var_h += VAR_Shr(r, 3);                                                 // alfa = 1/8
+        var_v += VAR_Shr(r, 3);                                                 // beta/dt = (1/128)*16 = 1/8
+    }
+
+    if(--var_contador)
+        return 0;
+    var_contador = VAR_DISPLAY;
+    return 1;
+}
+
+// Retorna a altitude filtrada em cm
+long VAR_Altitude(void) {
+    return VAR_Shr(var_h, VAR_FRACAO);
+}
+
+// Retorna a velocidade vertical filtrada em cm/s
+long VAR_Rate(void) {
+    return VAR_Shr(var_v, VAR_FRACAO);
+}
+
+#endif
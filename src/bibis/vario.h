@@ -0,0 +1,77 @@
+/******************************************************************************
+ * Biblioteca: Variômetro (vario.h)
+ * Autor: Elison Nogueira
+ * Data: 18/10/2026
+ * Versão: 1.0
+ * Plataforma: PIC18F25K50 (Microchip)
+ * Compilador: mikroC Pro for PIC v7.6.0
+ *
+ * Descrição:
+ * Modo variômetro: estima a velocidade vertical a partir da pressão lida a
+ * 16Hz. Enquanto ativo, o BME280 fica em modo normal com a configuração de
+ * alta taxa abaixo e o laço principal compensa só temperatura (para t_fine)
+ * e pressão a cada VAR_PERIODO. A leitura ambiental (saúde, alarmes,
+ * previsor, histórico e HID) continua a cada VAR_AMBIENTE sobre os brutos da
+ * última amostra, sem nova medida; só o nível adaptativo fica parado, pois
+ * ele reconfiguraria o sensor. A umidade é convertida junto (x1) para os
+ * alarmes de umidade seguirem valendo, mas só é compensada nessa leitura.
+ *
+ *   Configuração: normal, P x8, T x1, UR x1, filtro 4, standby 0.5ms
+ *   t_medição,max = 1.25 + 2.3*1 + (2.3*8 + 0.575) + (2.3*1 + 0.575)
+ *                 = 25.4ms (ODR ~39Hz)
+ *
+ * Altitude da atmosfera padrão, h = 44330 * (1 - (p/101325)^(1/5.255)), por
+ * uma tabela de 1024 em 1024 Pa (300 a 1109 hPa) com interpolação por
+ * deslocamento; erro absoluto abaixo de 0.8m, sem efeito na taxa. Abaixo
+ * de 300 hPa e acima de 1109 hPa a altitude satura na entrada da ponta.
+ *
+ * Filtro alfa-beta com passo fixo dt = 1/16 s (256 ticks do RTC), para que
+ * todas as multiplicações sejam deslocamentos:
+ *   previsão: h' = h + v*dt
+ *   resíduo:  r  = z - h'
+ *   correção: h  = h' + alfa*r,  v = v + (beta/dt)*r
+ * com alfa = 1/8 e beta = 1/128 (beta = alfa²/(2 - alfa), Benedict-Bordner),
+ * h e v em cm e cm/s com 4 bits de fração. Constante de tempo da taxa
+ * de ~1s: suficiente para áudio e display sem reagir ao ruído do sensor.
+ * Resíduos abaixo de 0.5cm (8 em Q4) somem no deslocamento e não corrigem
+ * h nem v: parado e sem ruído, a taxa fica exatamente em zero.
+ *
+ * No host (vario_teste.c), com ruído gaussiano de 1Pa e a pressão em Pa
+ * inteiros, a taxa a 1m/s sai com viés abaixo de 0.3cm/s e desvio RMS de
+ * 2.3cm/s ao nível do mar e 3.1cm/s a 3000m (picos de até 12cm/s); chega a
+ * 63% de um degrau de taxa em ~1.2s. Sem ruído o erro fica em até 3cm/s (Pa
+ * inteiro e cm/s truncado).
+ *
+ * Orçamento por amostra: 62.5ms para leitura I2C, compensação T/P, tabela,
+ * filtro e, a cada 2 amostras (8Hz), o redesenho dos caracteres alterados.
+ * O slot VARIO do comando PERF (perf.h) mede a amostra com o redesenho; MAX
+ * acima de 62500us significa que a placa não sustenta os 16Hz.
+ *****************************************************************************/
+
+#ifndef VARIO_H
+#define VARIO_H
+
+#include "config.h"
+
+#define VAR_PERIODO       256                                                   // 1/16 s em ticks do RTC
+#define VAR_AMBIENTE      8192                                                  // 2s em ticks do RTC: leitura ambiental no variômetro
+#define VAR_DISPLAY       2                                                     // Amostras por atualização do display (8Hz)
+
+#if USE_DISPLAY
+
+// Protótipos das funções
+void VAR_Start(void);                                                           // Entra no modo variômetro
+void VAR_Stop(void);                                                            // Restaura a configuração anterior
+unsigned char VAR_Active(void);                                                 // 1 = modo variômetro ativo
+unsigned char VAR_Sample(void);                                                 // Lê e filtra (1 = hora de redesenhar)
+long VAR_Altitude(void);                                                        // Altitude filtrada (cm)
+long VAR_Rate(void);                                                            // Velocidade vertical (cm/s)
+
+#else
+
+// Sem display não há página que ligue o variômetro
+#define VAR_Active()      0
+
+#endif
+
+#endif
@@ -0,0 +1,281 @@
+/******************************************************************************
+ * Teste no host: Altitude e filtro do variômetro (vario_teste.c)
+ * Autor: Elison Nogueira
+ * Data: 18/10/2026
+ * Versão: 1.0
+ * Plataforma: PC (gcc)
+ *
+ * Descrição:
+ * Compila o vario.c do firmware com o sensor substituído por uma pressão
+ * simulada e confere:
+ *
+ *   Teste         Verifica
+ *   Tabela        Cada entrada contra a atmosfera padrão (até 1cm); todo Pa
+ *                 de 300 a 1109 hPa com erro abaixo de TST_ERRO_ALT;
+ *                 saturação abaixo da primeira e acima da última entrada;
+ *                 altitude nunca sobe com a pressão (0 a 2000 hPa)
+ *   Zona morta    Com v = 0 e h a menos de 0.5cm da medida (resíduo < 8 em
+ *                 Q4) VAR_Sample não mexe em h nem em v; com 0.5cm mexe
+ *   Rastreio      VAR_Sample a 16Hz parado por TST_PARADO s, subindo (ou
+ *                 descendo) por TST_SUBIDA s e parado de novo, a 0 e 3000m,
+ *                 com ruído gaussiano na pressão arredondada para Pa como
+ *                 ReadPressure; TST_REPETICOES sorteios por caso
+ *
+ * No rastreio, a taxa (VAR_Rate, o que o display mostra) é comparada
+ * depois de TST_ACOMODA s de cada mudança: viés, desvio RMS e pico na
+ * subida, maior taxa parado e maior erro da altitude. A resposta é o
+ * primeiro instante em que a taxa chega a 63% da subida. Falha se o RMS a
+ * 1m/s com 1Pa de ruído passar de TST_ERRO_V, ou se sem ruído o pico passar
+ * de TST_ERRO_QUANT (Pa inteiro e cm/s truncado) ou a taxa parado não for
+ * zero (a zona morta segura o filtro).
+ *
+ * Não compila sozinho: teste_host.py copia o vario.c com os tipos do mikroC
+ * e compila este arquivo contra ele (veja lá).
+ *
+ * Uso: python3 teste_host.py vario
+ * Sai com 1 se alguma verificação falhar.
+ *****************************************************************************/
+
+#include <stdio.h>
+#include <stdint.h>
+#include <math.h>
+
+#include "vario_host.c"
+
+#define TST_ERRO_ALT      0.8                                                   // Maior erro da tabela (m)
+#define TST_PARADO        20.0                                                  // Parado antes e depois (s)
+#define TST_SUBIDA        60.0                                                  // Duração da subida (s)
+#define TST_ACOMODA       10.0                                                  // Acomodação do filtro (s)
+#define TST_REPETICOES    20                                                    // Sorteios de ruído por caso
+#define TST_ERRO_V        5.0                                                   // Maior RMS da taxa a 1m/s e 1Pa (cm/s)
+#define TST_ERRO_QUANT    3.0                                                   // Maior erro da taxa sem ruído (cm/s)
+
+// Substitutos do driver: ReadPressure devolve a pressão simulada
+config_bme280 BME280_cfg;
+uint32_t tst_pressao;
+
+void BME280_Configure(bme280_mode mode, bme280_sampling osrs_t, bme280_sampling osrs_h,
+                      bme280_sampling osrs_p, bme280_filter filter, standby_time sb) {
+    BME280_cfg.mode = mode;
+}
+
+void BME280_MarkConversion(void) { }
+void BME280_Update(void) { }
+
+uint8_t ReadPressure(uint32_t *pres) {
+    *pres = tst_pressao;
+    return 1;
+}
+
+uint32_t tst_semente = 1;
+unsigned int tst_erros;
+
+// Sorteio reprodutível (xorshift de 32 bits) em [0, 1)
+static double TST_Random(void) {
+    tst_semente ^= tst_semente << 13;
+    tst_semente ^= tst_semente >> 17;
+    tst_semente ^= tst_semente << 5;
+    return (tst_semente >> 8) / 16777216.0;
+}
+
+// Sorteio gaussiano de desvio padrão 1 (Box-Muller)
+static double TST_Gauss(void) {
+    double u = TST_Random();
+
+    return sqrt(-2 * log(1 - u)) * cos(2 * M_PI * TST_Random());
+}
+
+// Atmosfera padrão: altitude (m) da pressão (Pa) e o inverso
+static double TST_Altitude(double p) {
+    return 44330.0 * (1 - pow(p / 101325.0, 1 / 5.255));
+}
+
+static double TST_Pressure(double h) {
+    return 101325.0 * pow(1 - h / 44330.0, 5.255);
+}
+
+static void TST_Fim(const char *teste, unsigned int falhas) {
+    printf("%-12s %s\n", teste, falhas ? "FALHOU" : "ok");
+    if(falhas)
+        tst_erros++;
+}
+
+// Tabela de altitude: entradas, erro na faixa, saturação e monotonia
+static void TST_Table(void) {
+    unsigned int falhas = 0;
+    uint32_t p;
+    double erro, pior = 0;
+    int32_t h, anterior;
+
+    for(p = 0; p < VAR_TAB_QTD; p++) {
+        if(fabs(var_altitude[p] - 100 * TST_Altitude(VAR_TAB_INICIO + 1024.0 * p)) > 1.0) {
+            printf("  entrada %u = %d, fórmula %.1f\n", p, var_altitude[p],
+                   100 * TST_Altitude(VAR_TAB_INICIO + 1024.0 * p));
+            falhas++;
+        }
+    }
+
+    for(p = VAR_TAB_INICIO; p <= VAR_TAB_INICIO + 1024UL * (VAR_TAB_QTD - 1); p++) {
+        erro = fabs(VAR_PressureToAltitude(p) / 100.0 - TST_Altitude(p));
+        if(erro > pior)
+            pior = erro;
+    }
+    printf("  erro máx. da tabela de 300 a 1109 hPa: %.3fm\n", pior);
+    if(pior >= TST_ERRO_ALT)
+        falhas++;
+
+    // Abaixo da primeira entrada e acima da última a altitude satura
+    if(VAR_PressureToAltitude(0) != var_altitude[0] ||
+       VAR_PressureToAltitude(VAR_TAB_INICIO - 1) != var_altitude[0] ||
+       VAR_PressureToAltitude(VAR_TAB_INICIO) != var_altitude[0])
+        falhas++;
+    p = VAR_TAB_INICIO + 1024UL * (VAR_TAB_QTD - 1);
+    if(VAR_PressureToAltitude(p - 1) <= var_altitude[VAR_TAB_QTD - 1] ||
+       VAR_PressureToAltitude(p) != var_altitude[VAR_TAB_QTD - 1] ||
+       VAR_PressureToAltitude(p + 1) != var_altitude[VAR_TAB_QTD - 1] ||
+       VAR_PressureToAltitude(200000) != var_altitude[VAR_TAB_QTD - 1])
+        falhas++;
+
+    anterior = VAR_PressureToAltitude(0);
+    for(p = 1; p <= 200000; p++) {
+        h = VAR_PressureToAltitude(p);
+        if(h > anterior)
+            falhas++;
+        anterior = h;
+    }
+
+    TST_Fim("Tabela", falhas);
+}
+
+// Resíduo abaixo de 0.5cm (8 em Q4) não corrige h nem v
+static void TST_Deadband(void) {
+    unsigned int falhas = 0;
+    int32_t z, k, h;
+
+    VAR_Start();
+    tst_pressao = 101325;
+    VAR_Sample();                                                               // Inicia o filtro em z
+    z = VAR_PressureToAltitude(tst_pressao) << VAR_FRACAO;
+
+    for(k = -8; k <= 8; k++) {
+        h = z - k;                                                              // Resíduo z - h = k
+        var_h = h;
+        var_v = 0;
+        VAR_Sample();
+        if(k > -8 && k < 8) {
+            if(var_h != h || var_v != 0)
+                falhas++;
+        } else if(var_h != h + k / 8 || var_v != k / 8) {
+            falhas++;
+        }
+    }
+
+    TST_Fim("Zona morta", falhas);
+}
+
+// Resultado de um caso de rastreio (todas as repetições)
+typedef struct {
+    double vies;                                                                // Média de v - taxa na subida (cm/s)
+    double rms;                                                                 // Desvio RMS de v na subida (cm/s)
+    double pico;                                                                // Maior |v - taxa| na subida (cm/s)
+    double parado;                                                              // Maior |v| parado (cm/s)
+    double altura;                                                              // Maior |h - altitude| (cm)
+    double resposta;                                                            // Até 63% da taxa, sem ruído (s)
+} tst_rastreio;
+
+// Sobe a taxa (m/s) a partir de h0 (m) com ruído (Pa) e mede o filtro
+static void TST_Track(double h0, double taxa, double ruido, tst_rastreio *r) {
+    double t, h, v, erro, fim, soma = 0, soma2 = 0;
+    unsigned int i, n, rep, conta = 0;
+
+    r->pico = r->parado = r->altura = 0;
+    r->resposta = -1;
+    fim = TST_PARADO + TST_SUBIDA;
+    n = (unsigned int)((2 * TST_PARADO + TST_SUBIDA) * 16);
+
+    for(rep = 0; rep < TST_REPETICOES; rep++) {
+        VAR_Start();
+        for(i = 0; i < n; i++) {
+            t = i / 16.0;
+            if(t < TST_PARADO)
+                h = h0;
+            else if(t < fim)
+                h = h0 + taxa * (t - TST_PARADO);
+            else
+                h = h0 + taxa * TST_SUBIDA;
+
+            tst_pressao = (uint32_t)floor(TST_Pressure(h) + ruido * TST_Gauss() + 0.5);
+            VAR_Sample();
+            v = VAR_Rate();
+
+            if(r->resposta < 0 && t >= TST_PARADO && fabs(v) >= 63 * fabs(taxa))
+                r->resposta = t - TST_PARADO;
+
+            if(t < TST_ACOMODA || (t >= TST_PARADO && t < TST_PARADO + TST_ACOMODA) ||
+               (t >= fim && t < fim + TST_ACOMODA))
+                continue;                                                       // Filtro acomodando
+
+            if(t < TST_PARADO || t >= fim) {
+                if(fabs(v) > r->parado)
+                    r->parado = fabs(v);
+            } else {
+                erro = v - taxa * 100;
+                soma += erro;
+                soma2 += erro * erro;
+                conta++;
+                if(fabs(erro) > r->pico)
+                    r->pico = fabs(erro);
+            }
+            erro = fabs(VAR_Altitude() - 100 * TST_Altitude(TST_Pressure(h)));
+            if(erro > r->altura)
+                r->altura = erro;
+        }
+        if(ruido == 0)                                                          // Sem ruído as repetições são iguais
+            break;
+    }
+
+    r->vies = soma / conta;
+    r->rms = sqrt(soma2 / conta - r->vies * r->vies);
+}
+
+// Filtro em subidas e descidas, com e sem ruído
+static void TST_Tracking(void) {
+    static const double taxas[] = {0.3, 1.0, 3.0, -1.0};
+    static const double ruidos[] = {0.0, 1.0, 2.0};
+    static const double alturas[] = {0.0, 3000.0};
+    unsigned int falhas = 0, a, i, j;
+    unsigned char falhou;
+    tst_rastreio r;
+
+    printf("  Altura  Taxa     Ruído  Viés     RMS      Pico     Parado   Altura   Resposta\n");
+    for(a = 0; a < 2; a++) {
+        for(j = 0; j < 3; j++) {
+            for(i = 0; i < 4; i++) {
+                TST_Track(alturas[a], taxas[i], ruidos[j], &r);
+
+                falhou = 0;
+                if(ruidos[j] == 0 && (r.pico > TST_ERRO_QUANT || r.parado > 0))
+                    falhou = 1;
+                if(ruidos[j] == 1.0 && taxas[i] == 1.0 && r.rms > TST_ERRO_V)
+                    falhou = 1;
+                if(falhou)
+                    falhas++;
+
+                printf("  %5.0fm  %+4.1fm/s  %2.0fPa  %+6.2f  %6.2f  %6.1f  %6.1f  %6.1fcm  %5.2fs%s\n",
+                       alturas[a], taxas[i], ruidos[j], r.vies, r.rms, r.pico, r.parado,
+                       r.altura, r.resposta, falhou ? "  FALHOU" : "");
+            }
+        }
+    }
+
+    TST_Fim("Rastreio", falhas);
+}
+
+int main(void) {
+    TST_Table();
+    TST_Deadband();
+    TST_Tracking();
+
+    printf(tst_erros ? "FALHOU: %u testes\n" : "OK\n", tst_erros);
+    return tst_erros != 0;
+}
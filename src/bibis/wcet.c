@@ -0,0 +1,309 @@
+/******************************************************************************
+ * Biblioteca: Pior caso de tempo da compensação (wcet.c)
+ * Autor: Elison Nogueira
+ * Data: 18/10/2026
+ * Versão: 1.0
+ * Plataforma: PIC18F25K50 (Microchip)
+ * Compilador: mikroC Pro for PIC v7.6.0
+ *
+ * Descrição:
+ * Varredura de calibrações e brutos medida no Timer0. Veja wcet.h.
+ ******************************************************************************/
+
+#include "wcet.h"
+
+#if USE_WCET
+
+#include "bme280.h"
+#include "perf.h"
+#include "mult.h"
+#if USE_CONST_TIME
+#include "ajustes.h"
+#endif
+
+#define WCET_CANTOS       5
+#define WCET_TODOS        (BME280_CANAL_T | BME280_CANAL_H | BME280_CANAL_P | BME280_CALIBRACAO)
+
+wcet_caso wcet_pior[WCET_QTD];                                                  // Pior caso de cada função
+unsigned int wcet_semente;                                                      // Estado do xorshift
+unsigned int wcet_ciclos[WCET_MULS];                                            // Ciclos por chamada de cada multiplicação
+volatile long wcet_descarte;                                                    // Guarda os produtos (o laço não some)
+#if USE_CONST_TIME
+wcet_nivelado wcet_nivel;                                                       // Estágio COMPENSACAO com a espera
+unsigned int wcet_estagio;                                                      // Maior tempo do estágio sem a espera
+unsigned long wcet_espera_soma;                                                 // Soma das esperas
+unsigned int wcet_amostras;
+#endif
+
+// Cantos do ADC: zero, um, meio da faixa, valor de canal pulado e máximo
+const long wcet_cantos_20[WCET_CANTOS] = {0, 1, 0x7FFFF, 0x80000, 0xFFFFF};     // adc_T e adc_P (20 bits)
+const long wcet_cantos_16[WCET_CANTOS] = {0, 1, 0x7FFF, 0x8000, 0xFFFF};        // adc_H (16 bits)
+
+// Próximo valor do xorshift de 16 bits (7, 9, 8)
+static unsigned int WCET_Random(void) {
+    wcet_semente ^= wcet_semente << 7;
+    wcet_semente ^= wcet_semente >> 9;
+    wcet_semente ^= wcet_semente << 8;
+
+    return wcet_semente;
+}
+
+// Todos os coeficientes num extremo do tipo (sem sinal sempre no máximo)
+static void WCET_Extremes(int s16, int s12, short s8) {
+    BME280_calib.dig_T1 = 65535;
+    BME280_calib.dig_T2 = s16;
+    BME280_calib.dig_T3 = s16;
+    BME280_calib.dig_P1 = 65535;
+    BME280_calib.dig_P2 = s16;
+    BME280_calib.dig_P3 = s16;
+    BME280_calib.dig_P4 = s16;
+    BME280_calib.dig_P5 = s16;
+    BME280_calib.dig_P6 = s16;
+    BME280_calib.dig_P7 = s16;
+    BME280_calib.dig_P8 = s16;
+    BME280_calib.dig_P9 = s16;
+    BME280_calib.dig_H1 = 255;
+    BME280_calib.dig_H2 = s16;
+    BME280_calib.dig_H3 = 255;
+    BME280_calib.dig_H4 = s12;                                                  // H4 e H5 têm 12 bits com sinal
+    BME280_calib.dig_H5 = s12;
+    BME280_calib.dig_H6 = s8;
+}
+
+// Carrega a calibração do conjunto (veja a tabela em wcet.h)
+static void WCET_Calibration(unsigned char conjunto, calib_bme280 *unidade) {
+    BME280_calib = *unidade;
+
+    switch(conjunto) {
+        case 1:                                                                 // Exemplo do datasheet do BMP280
+            BME280_calib.dig_T1 = 27504;
+            BME280_calib.dig_T2 = 26435;
+            BME280_calib.dig_T3 = -1000;
+            BME280_calib.dig_P1 = 36477;
+            BME280_calib.dig_P2 = -10685;
+            BME280_calib.dig_P3 = 3024;
+            BME280_calib.dig_P4 = 2855;
+            BME280_calib.dig_P5 = 140;
+            BME280_calib.dig_P6 = -7;
+            BME280_calib.dig_P7 = 15500;
+            BME280_calib.dig_P8 = -14600;
+            BME280_calib.dig_P9 = 6000;
+            break;
+
+        case 2:
+            WCET_Extremes(-32768, -2048, -128);
+            break;
+
+        case 3:
+            WCET_Extremes(32767, 2047, 127);
+            break;
+    }
+}
+
+// Guarda a medida se for o maior tempo visto da função
+static void WCET_Save(unsigned char funcao, unsigned int us, unsigned char conjunto) {
+    wcet_caso *c;
+
+    c = &wcet_pior[funcao];
+    if(us <= c->us)
+        return;
+
+    c->us = us;
+    c->conjunto = conjunto;
+    c->adc_T = adc_T;
+    c->adc_P = adc_P;
+    c->adc_H = adc_H;
+}
+
+// Mede uma chamada só com a compensação no tempo (interrupções desligadas)
+#define WCET_MEDE(funcao, chamada)                                             \
+    gie = INTCON & 0x80;                                                       \
+    GIE_bit = 0;                                                               \
+    PERF_Start();                                                              \
+    chamada;                                                                   \
+    us = PERF_Elapsed();                                                       \
+    if(gie) GIE_bit = 1;                                                       \
+    WCET_Save(funcao, us, conjunto)
+
+#if USE_CONST_TIME
+// Estágio COMPENSACAO do pipeline com os três canais novos; sem nivelar
+// guarda o maior tempo, nivelando mede o tempo com a espera
+static void WCET_Stage(unsigned char nivelar) {
+    long temp;
+    unsigned long valor;
+    unsigned int us, livre;
+    unsigned char gie;
+
+    BME280_Invalidate(WCET_TODOS);
+    gie = INTCON & 0x80;
+    GIE_bit = 0;
+    PERF_Start();
+    ReadTemperature(&temp);
+    ReadHumidity(&valor);
+    ReadPressure(&valor);
+    livre = nivelar ? PIPE_Pad() : PERF_Elapsed();
+    us = PERF_Elapsed();
+    if(gie) GIE_bit = 1;
+
+    if(!nivelar) {
+        if(livre > wcet_estagio)
+            wcet_estagio = livre;
+        return;
+    }
+
+    if(us < wcet_nivel.min)
+        wcet_nivel.min = us;
+    if(us > wcet_nivel.max)
+        wcet_nivel.max = us;
+    if(livre >= ajustes.orcamento)
+        wcet_nivel.estouros++;
+    wcet_espera_soma += us - livre;
+    wcet_amostras++;
+}
+#endif
+
+// Mede as quatro funções com os brutos atuais; nivelando, só o estágio
+static void WCET_Sample(unsigned char conjunto, unsigned char nivelar) {
+    long temp;
+    unsigned long valor;
+    unsigned int us;
+    unsigned char gie;
+
+#if USE_CONST_TIME
+    WCET_Stage(nivelar);
+    if(nivelar)
+        return;
+#endif
+
+    BME280_Invalidate(WCET_TODOS);                                              // t_fine, parte fixa e recíproco novos
+    WCET_MEDE(WCET_TEMP, ReadTemperature(&temp));
+    WCET_MEDE(WCET_UMID, ReadHumidity(&valor));
+    WCET_MEDE(WCET_PRES, ReadPressure(&valor));
+
+    BME280_Invalidate(BME280_CANAL_P);                                          // Mesmo t_fine: parte fixa guardada
+    WCET_MEDE(WCET_PRES_C, ReadPressure(&valor));
+}
+
+// Uma passada por todas as calibrações e brutos
+static void WCET_Sweep(calib_bme280 *unidade, unsigned char nivelar) {
+    unsigned char conjunto, i, j;
+    unsigned int n;
+
+    for(conjunto = 0; conjunto < WCET_CONJUNTOS; conjunto++) {
+        WCET_Calibration(conjunto, unidade);
+
+        for(i = 0; i < WCET_CANTOS; i++) {
+            for(j = 0; j < WCET_CANTOS; j++) {
+                adc_T = wcet_cantos_20[i];
+                adc_P = wcet_cantos_20[j];
+                adc_H = wcet_cantos_16[(i + j) % WCET_CANTOS];                  // Cada canto de H com cinco pares T, P
+                WCET_Sample(conjunto, nivelar);
+            }
+        }
+
+        wcet_semente = 1;                                                       // Mesmos brutos em todos os conjuntos
+        for(n = 0; n < WCET_ALEATORIOS; n++) {
+            adc_T = ((long)WCET_Random() << 4) | (WCET_Random() & 0x0F);
+            adc_P = ((long)WCET_Random() << 4) | (WCET_Random() & 0x0F);
+            adc_H = WCET_Random();
+            WCET_Sample(conjunto, nivelar);
+        }
+    }
+}
+
+// Laço de WCET_VEZES produtos com operandos sorteados; deixa o tempo em us
+#define WCET_LACO(produto)                                                     \
+    wcet_semente = 1;                                                          \
+    r = 0;                                                                     \
+    gie = INTCON & 0x80;                                                       \
+    GIE_bit = 0;                                                               \
+    PERF_Start();                                                              \
+    for(n = 0; n < WCET_VEZES; n++) {                                          \
+        a = ((long)WCET_Random() << 16) | WCET_Random();                       \
+        b = WCET_Random();                                                     \
+        r ^= produto;                                                          \
+    }                                                                          \
+    us = PERF_Elapsed();                                                       \
+    if(gie) GIE_bit = 1;                                                       \
+    wcet_descarte = r
+
+// Ciclos por chamada: tempo do laço menos o do laço vazio, 4 ciclos por us
+#define WCET_MUL(mul, produto)                                                 \
+    WCET_LACO(produto);                                                        \
+    wcet_ciclos[mul] = us > vazio ? ((unsigned long)(us - vazio) * 4 + WCET_VEZES / 2) / WCET_VEZES : 0
+
+// Mede as multiplicações de mult.h e o long * long do compilador
+static void WCET_Multiplications(void) {
+    long a, r;
+    unsigned int b, us, vazio;
+    unsigned char n, gie;
+
+    WCET_LACO(a ^ b);                                                           // Mesmo laço sem multiplicação
+    vazio = us;
+
+    WCET_MUL(WCET_MUL_32X16, MUL_32x16(a, (int)b));
+    WCET_MUL(WCET_MUL_32XU16, MUL_32xU16(a, b));
+    WCET_MUL(WCET_MUL_16X16U, (long)MUL_16x16U((unsigned int)a, b));
+    WCET_MUL(WCET_MUL_LONG, a * (long)(int)b);
+}
+
+// Varre as calibrações com os brutos dos cantos e os pseudoaleatórios
+void WCET_Run(void) {
+    calib_bme280 unidade;
+    long t, p, h;
+    unsigned char i;
+
+    // Calibração e brutos da unidade, devolvidos no fim
+    unidade = BME280_calib;
+    t = adc_T;
+    p = adc_P;
+    h = adc_H;
+
+    for(i = 0; i < WCET_QTD; i++)
+        wcet_pior[i].us = 0;
+#if USE_CONST_TIME
+    wcet_nivel.min = 0xFFFF;
+    wcet_nivel.max = 0;
+    wcet_nivel.estouros = 0;
+    wcet_estagio = 0;
+    wcet_espera_soma = 0;
+    wcet_amostras = 0;
+#endif
+
+    WCET_Sweep(&unidade, 0);
+#if USE_CONST_TIME
+    // Orçamento do pior caso e da margem, depois o estágio com a espera
+    ajustes.orcamento = wcet_estagio + (wcet_estagio >> PIPE_MARGEM);
+    WCET_Sweep(&unidade, 1);
+#endif
+
+    BME280_calib = unidade;
+    adc_T = t;
+    adc_P = p;
+    adc_H = h;
+    BME280_Invalidate(WCET_TODOS);
+#if USE_CONST_TIME
+    wcet_nivel.espera = (wcet_espera_soma + wcet_amostras / 2) / wcet_amostras;
+#endif
+
+    WCET_Multiplications();
+}
+
+// Retorna o pior caso da função
+wcet_caso *WCET_Get(unsigned char funcao) {
+    return &wcet_pior[funcao];
+}
+
+// Retorna os ciclos por chamada de uma multiplicação
+unsigned int WCET_MulCycles(unsigned char mul) {
+    return wcet_ciclos[mul];
+}
+
+#if USE_CONST_TIME
+// Retorna as medidas do estágio com a espera
+wcet_nivelado *WCET_Level(void) {
+    return &wcet_nivel;
+}
+#endif
+
+#endif
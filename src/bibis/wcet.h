@@ -0,0 +1,120 @@
+/******************************************************************************
+ * Biblioteca: Pior caso de tempo da compensação (wcet.h)
+ * Autor: Elison Nogueira
+ * Data: 18/10/2026
+ * Versão: 1.0
+ * Plataforma: PIC18F25K50 (Microchip)
+ * Compilador: mikroC Pro for PIC v7.6.0
+ *
+ * Descrição:
+ * Varredura de bancada que mede no próprio PIC o tempo da compensação do
+ * BME280 para muitas entradas e guarda o maior de cada função, com a
+ * entrada que o causou. O tempo depende dos dados: as divisões de long do
+ * compilador são rotinas de software, e a compensação tem ramos que
+ * dependem dos valores (sinal do coeficiente em MUL_32x16, quadrado em
+ * 16x16 ou 32x32, p < 0x80000000 na pressão, divisor abaixo de 65536).
+ * Medir no alvo dispensa um modelo de ciclos da biblioteca do mikroC.
+ *
+ *   Função   Trecho medido
+ *   T        ReadTemperature com o bruto novo (t_fine)
+ *   H        ReadHumidity com t_fine já em dia
+ *   P        ReadPressure com a parte fixa e o recíproco refeitos (pior
+ *            caso: t_fine e divisor novos)
+ *   PC       ReadPressure com a parte fixa guardada (só o bruto mudou)
+ *
+ * Calibrações varridas (WCET_CONJUNTOS):
+ *   0  A do sensor desta unidade (lida na partida)
+ *   1  T e P do exemplo do datasheet do BMP280 (mesma fórmula), H da unidade
+ *   2  Extremos negativos: coeficientes com sinal no mínimo do tipo, sem
+ *      sinal no máximo (ramo de correção de sinal em todo produto)
+ *   3  Extremos positivos: todos os coeficientes no máximo do tipo
+ *
+ * Para cada calibração: as combinações de brutos nos cantos do ADC (0, 1,
+ * meio da faixa, 0x80000 de canal pulado e o máximo) e WCET_ALEATORIOS
+ * brutos pseudoaleatórios (xorshift de 16 bits, semente fixa, resultado
+ * reprodutível). Uma população de sensores reais se cobre rodando WCET em
+ * cada unidade da bancada e tomando o maior valor entre elas.
+ *
+ * Cada medida é feita com as interrupções desligadas (só a compensação
+ * entra no tempo). Resolução de 1us no Timer0 (4 ciclos de instrução a
+ * 16MHz): some a margem do PERF do estágio COMPENSACAO para o orçamento do
+ * escalonador. A varredura leva alguns segundos e bloqueia o laço; não mande
+ * nada pela serial até a resposta. Ao fim a calibração e os brutos da
+ * unidade voltam e os canais são compensados de novo.
+ *
+ * A mesma varredura mede as multiplicações de mult.h e o long * long do
+ * compilador em ciclos de instrução por chamada: WCET_VEZES chamadas com
+ * operandos pseudoaleatórios (32 x 16 bits, os dois sinais), menos o mesmo
+ * laço sem a multiplicação, vezes 4 ciclos/us, dividido por WCET_VEZES. Com
+ * USE_MUL_8X8 = 0 as três rotinas viram o long * long e medem igual a ele.
+ *
+ * Com USE_CONST_TIME a varredura também mede o orçamento do tempo
+ * constante (pipeline.h). Na primeira passada cada entrada passa pelo
+ * estágio COMPENSACAO inteiro, como no pipeline (T, H e P novos), sem a
+ * espera; o maior tempo mais 1/2^PIPE_MARGEM dele vira ajustes.orcamento
+ * (SAVE grava). Uma segunda passada repete as entradas com a espera de
+ * PIPE_Pad: o menor e o maior tempo mostram se o estágio é mesmo
+ * constante, a espera média é o custo por amostra nova e os estouros
+ * contam as entradas que chegaram ao orçamento antes da espera (com a
+ * margem e sem interrupções, devem ser zero).
+ *
+ * Só existe com USE_WCET = 1 (config.h); é ferramenta de bancada.
+ *
+ * Dependências:
+ * - Compensação do BME280 (bme280.h)
+ * - Timer0 (perf.h)
+ * - Multiplicações 32x16 (mult.h)
+ * - Espera do tempo constante (pipeline.h) e orçamento nos ajustes
+ *   (ajustes.h), com USE_CONST_TIME
+ *****************************************************************************/
+
+#ifndef WCET_H
+#define WCET_H
+
+#include "config.h"
+
+#if USE_WCET
+
+#define WCET_CONJUNTOS    4                                                     // Calibrações varridas
+#define WCET_ALEATORIOS   256                                                   // Brutos pseudoaleatórios por calibração
+
+// Funções medidas
+#define WCET_TEMP         0
+#define WCET_UMID         1
+#define WCET_PRES         2                                                     // Parte fixa e recíproco refeitos
+#define WCET_PRES_C       3                                                     // Parte fixa guardada
+#define WCET_QTD          4
+
+// Multiplicações medidas (ciclos por chamada)
+#define WCET_MUL_32X16    0                                                     // MUL_32x16
+#define WCET_MUL_32XU16   1                                                     // MUL_32xU16
+#define WCET_MUL_16X16U   2                                                     // MUL_16x16U
+#define WCET_MUL_LONG     3                                                     // long * long do compilador
+#define WCET_MULS         4
+#define WCET_VEZES        64                                                    // Chamadas medidas por multiplicação
+
+// Entrada que deu o maior tempo de uma função
+typedef struct {
+    unsigned int us;                                                            // Maior tempo (us)
+    unsigned char conjunto;                                                     // Calibração (0..WCET_CONJUNTOS-1)
+    long adc_T, adc_P, adc_H;                                                   // Brutos
+} wcet_caso;
+
+// Estágio COMPENSACAO com a espera do tempo constante (USE_CONST_TIME)
+typedef struct {
+    unsigned int min, max;                                                      // Tempo com a espera (us)
+    unsigned int espera;                                                        // Espera média por amostra: o custo (us)
+    unsigned int estouros;                                                      // Entradas que chegaram ao orçamento antes da espera
+} wcet_nivelado;
+
+// Protótipos das funções
+void WCET_Run(void);                                                            // Varre calibrações e brutos (bloqueia alguns segundos)
+wcet_caso *WCET_Get(unsigned char funcao);                                      // Pior caso da função (WCET_TEMP..WCET_PRES_C)
+unsigned int WCET_MulCycles(unsigned char mul);                                 // Ciclos por chamada (WCET_MUL_32X16..WCET_MUL_LONG)
+#if USE_CONST_TIME
+wcet_nivelado *WCET_Level(void);                                                // Estágio com a espera (só com USE_CONST_TIME)
+#endif
+
+#endif
+
+#endif
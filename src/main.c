@@ -1,36 +1,43 @@
 /******************************************************************************
  * Projeto: Sistema de Monitoramento Ambiental com BME280 - Display Rotativo
  * Autor: Elison Nogueira
- * Data de Criao: 16/11/2024
- * Verso: 1.0
+ * Data de Criação: 16/11/2024
+ * Versão: 1.0
  * Plataforma: PIC18F25K50 (Microchip)
  * Compilador: mikroC Pro for PIC v7.6.0
  *
- * Descrio:
+ * Descrição:
  * Este projeto implementa um sistema de monitoramento ambiental que utiliza o
- * sensor BME280 para leitura de temperatura, umidade e presso atmosfrica. Os
- * dados so exibidos de forma rotativa em um display LCD 16x2 via I2C,
- * alternando entre as leituras a cada 2 segundos.
+ * sensor BME280 para leitura de temperatura, umidade e pressão atmosférica. Os
+ * dados são exibidos em páginas de um display LCD 16x2 via I2C, selecionadas
+ * por dois botões.
  *
- * Hardware Necessrio:
+ * Hardware Necessário:
  * - Microcontrolador PIC18F25K50 (16Mhz de clock)
  * - Sensor BME280 (I2C)
  * - Display LCD 16x2 (I2C)
- * - Fonte de alimentao 5V
- * - Fonte de alimentao 3V3 para o sensor
+ * - 2 botões em RB4/RB5 ligados ao GND
+ * - Fonte de alimentação 5V
+ * - Fonte de alimentação 3V3 para o sensor
  * - Logic Level Converter de 5V -> 3V3 (Para o SDA e SCL do BME280)
+ * - Conversor USB-serial em RC6/RC7 (opcional, para configuração)
  *
  * Funcionalidades:
- * - Leitura de temperatura, umidade e presso via BME280
- * - Exibio rotativa dos dados em display LCD
- * - Atualizao automtica a cada 2 segundos
+ * - Leitura de temperatura, umidade e pressão via BME280
+ * - Páginas de valores, mín/máx, tendência, diagnóstico, unidades e ajustes
+ * - Variômetro de 16Hz enquanto a página correspondente está aberta
+ * - Leitura e alteração da configuração pela serial (UART1, 19200 8N1)
+ * - Laço por prazos que dorme (IDLE/SLEEP) até a próxima tarefa
+ * - Atualização do display a cada amostra, sem bloquear a leitura
+ * - Perfil sem display (USE_DISPLAY = 0 em bibis/config.h) para unidades que
+ *   só registram ou transmitem: histórico maior e mensagens pela serial
  *
- * Referncias:
+ * Referências:
  * - Datasheet BME280
  * - Datasheet PIC18F25K50
- * - Documentao do MikroC Pro for PIC
+ * - Documentação do MikroC Pro for PIC
  *
- * Configuraes dos Registradores iniciais:
+ * Configurações dos Registradores iniciais:
  * - CONFIG1L : $300000 : 0x0000
  * - CONFIG1H : $300001 : 0x0003
  * - CONFIG2L : $300002 : 0x005F
@@ -46,125 +53,264 @@
   *****************************************************************************/
 
 // Incluindo bibliotecas
+#include "bibis/config.h"
 #include "bibis/bme280.h"
+#include "bibis/rtc.h"
+#include "bibis/alarme.h"
+#include "bibis/previsao.h"
+#include "bibis/adaptativo.h"
+#include "bibis/ajustes.h"
+#include "bibis/autoajuste.h"
+#include "bibis/saude.h"
+#include "bibis/interface.h"
+#include "bibis/unidades.h"
+#include "bibis/vario.h"
+#include "bibis/cmd.h"
+#include "bibis/sched.h"
+#include "bibis/perf.h"
+#include "bibis/pipeline.h"
+#if USE_DISPLAY
 #include "bibis/lcd_i2c.h"
+#include "bibis/lcd_fb.h"
+#endif
+#if USE_USB_HID
+#include "bibis/usb_sensor.h"
+#endif
 
-// Variveis globais
-signed long temperatura;                                                        // Armazena temperatura em centsimos de grau
-unsigned long pressao, umidade;                                                 // Armazena presso em Pa e umidade em 1024 passos
-char texto[16];                                                                 // Buffer para strings no LCD
-unsigned char estado_display = 0;                                               // Controla qual leitura ser exibida
+// Rotina de interrupção
+void interrupt() {
+    // Base de tempo (estouro do Timer1)
+    RTC_Isr();
 
-// Enumerao para controle do estado de exibio
-enum ESTADOS_DISPLAY {
-    MOSTRA_TEMPERATURA = 0,
-    MOSTRA_UMIDADE = 1,
-    MOSTRA_PRESSAO = 2
-};
+#if USE_DISPLAY
+    // Botões (mudança de estado e debounce pelo Timer2)
+    UI_Isr();
+#endif
+
+    // Recepção dos comandos pela serial
+    CMD_Isr();
+
+#if USE_USB_HID
+    // Pilha USB
+    USB_Interrupt_Proc();
+#endif
+}
+
+// Executa o auto-ajuste e grava o resultado na EEPROM
+void executar_ajuste() {
+#if USE_DISPLAY
+    I2C_LCD_Cmd(_LCD_CLEAR);
+    I2C_LCD_Out(1, 1, "Auto-ajuste...");
+    if(!TUNE_Run())
+        I2C_LCD_Out(2, 1, "Alvo n/ atingido");                                  // Usa o melhor possível
+#else
+    TUNE_Run();                                                                 // Sem alvo, usa o melhor possível
+#endif
+
+    ajustes.osrs_t = BME280_cfg.T_sampling;
+    ajustes.osrs_h = BME280_cfg.H_sampling;
+    ajustes.osrs_p = BME280_cfg.P_sampling;
+    ajustes.filtro = BME280_cfg.filter;
+    AJS_Save();
+
+    ADPT_Init();                                                                // Reaplica o modo do nível padrão
+#if USE_DISPLAY
+    FB_Invalidate();                                                            // O LCD foi escrito diretamente
+#endif
+}
 
 void inicializar_sistema() {
+#if USE_DISPLAY
     char txt[17];
+#else
+    char txt[12];
+#endif
+    unsigned char ajustes_ok, quente;
+
+    // Partida a quente (MCLR, WDT ou RESET sem queda de energia): o display e o
+    // sensor continuaram alimentados. POR/BOR voltam a 1 para a próxima partida
+    quente = POR_bit && BOR_bit;
+    POR_bit = 1;
+    BOR_bit = 1;
+
+    // Cronômetro de microssegundos (Timer0) para as medidas de perf.h
+    PERF_Init();
+
+    // Inicializa a base de tempo (Timer1 + cristal 32.768kHz)
+    RTC_Init();
 
-    // Inicializa comunicao I2C
+    // Configura as saídas dos alarmes
+    ALM_Init();
+
+    // Inicializa comunicação I2C
     I2C1_Init(100000);
-    delay_ms(100);
+    if(!quente)
+        delay_ms(100);                                                          // Subida da alimentação do LCD e do sensor
+
+    // Comandos de configuração pela serial (sem display, também as mensagens de partida)
+    CMD_Init();
+
+#if USE_DISPLAY
+    // Inicializa LCD; a quente só reconfigura se ele ainda estiver em 4 bits
+    PERF_Start();
+    if(quente && I2C_LCD_Resume()) {
+        PERF_Save(PERF_LCD_QUENTE, PERF_Elapsed());
+    } else {
+        I2C_LCD_Init();
+        PERF_Save(PERF_LCD_FRIO, PERF_Elapsed());
+    }
+#endif
 
-    // Inicializa LCD
-    I2C_LCD_Init();
+    // Prepara o previsor e grava seus ícones na CGRAM
+    PREV_Init();
+#if USE_DISPLAY
+    PREV_LoadIcons();
+#endif
+
+#if USE_USB_HID
+    // Inicia enumeração como sensor HID
+    HIDS_Init();
+#endif
 
     // Mensagem inicial
-    // Testa comunicao I2C
+    // Testa comunicação I2C
     ADD_BME280 = BME280_TestConnection();
     if(ADD_BME280 == 0) {
+#if USE_DISPLAY
         I2C_Lcd_Out(1, 1, "Erro I2C!");
         I2C_Lcd_Out(2, 1, "Sensor n/ found");
+#else
+        CMD_Send("ERR I2C");
+#endif
         while(1);
     } else {
+#if USE_DISPLAY
         sprintf(txt, "Add BME280: 0x%02X", ADD_BME280);
         I2C_Lcd_Out(1, 1, txt);
         sprintf(txt, "Iniciando...");
         I2C_Lcd_Out(2, 1, txt);
         Delay_ms(2000);
+#else
+        txt[0] = 0;
+        UN_FmtHex(txt + UN_Cat(txt, "BME280 0x"), ADD_BME280);                  // Sem sprintf no perfil sem display
+        CMD_Send(txt);
+#endif
     }
 
+    // Recupera da EEPROM o oversampling e o filtro da instalação
+    ajustes_ok = AJS_Load();
+
     // Inicializa BME280
-    if(!BME280_Begin(MODE_NORMAL, SAMPLING_X1, SAMPLING_X1, SAMPLING_X1, FILTER_OFF, STANDBY_0_5)) {
+    if(!BME280_Begin(MODE_NORMAL, ajustes.osrs_t, ajustes.osrs_h, ajustes.osrs_p, ajustes.filtro, STANDBY_0_5)) {
+#if USE_DISPLAY
         I2C_LCD_Out(1, 1, "Erro BME280!");
-        while(1);  // Trava execuo em caso de erro
+#else
+        CMD_Send("ERR BME280");
+#endif
+        while(1);                                                               // Trava execução em caso de erro
     }
-}
 
-void ler_sensor() {
-    // Realiza todas as leituras do sensor
-    ReadTemperature(&temperatura);
-    ReadHumidity(&umidade);
-    ReadPressure(&pressao);
-}
+    // Unidades de exibição escolhidas pelo usuário
+    UN_Select(ajustes.un_temp, ajustes.un_pres, ajustes.un_umid);
 
-void exibir_temperatura() {
-    I2C_LCD_Cmd(_LCD_CLEAR);
-    I2C_LCD_Out(1, 1, "Temperatura:");
+    // Inicia a amostragem adaptativa no nível gravado (ou automática)
+    ADPT_Lock(ajustes.nivel);
 
-    // Formata e exibe a temperatura
-    if(temperatura < 0) {
-        sprintf(texto, "-%d.%02d C", abs(temperatura/100), abs(temperatura%100));
-    } else {
-        sprintf(texto, "%d.%02d C", temperatura/100, temperatura%100);
-    }
-    I2C_LCD_Out(2, 1, texto);
-}
-
-void exibir_umidade() {
-    I2C_LCD_Cmd(_LCD_CLEAR);
-    I2C_LCD_Out(1, 1, "Umidade:");
-
-    // Formata e exibe a umidade
-    sprintf(texto, "%d.%d %%", umidade/1024, ((umidade*100)/1024)%100);
-    I2C_LCD_Out(2, 1, texto);
-}
-
-void exibir_pressao() {
-    I2C_LCD_Cmd(_LCD_CLEAR);
-    I2C_LCD_Out(1, 1, "Pressao:");
-
-    // Formata e exibe a presso
-    sprintf(texto, "%d.%d hPa", pressao/100, pressao%100);
-    I2C_LCD_Out(2, 1, texto);
-}
-
-void atualizar_display() {
-    // Seleciona qual informao exibir baseado no estado atual
-    switch(estado_display) {
-        case MOSTRA_TEMPERATURA:
-            exibir_temperatura();
-            break;
+    // Comissionamento: sem ajustes gravados, mede o ruído e escolhe a configuração
+    if(!ajustes_ok)
+        executar_ajuste();
 
-        case MOSTRA_UMIDADE:
-            exibir_umidade();
-            break;
+    // Zera o monitor de saúde do sensor
+    HLTH_Init();
 
-        case MOSTRA_PRESSAO:
-            exibir_pressao();
-            break;
-    }
+#if USE_DISPLAY
+    // Botões e páginas do display
+    UI_Init();
+#endif
 
-    // Avana para o prximo estado
-    estado_display = (estado_display + 1) % 3;
+    // Timer3 que acorda o laço no próximo prazo
+    SCH_Init();
 }
 
 void main() {
+    unsigned long prazo_leitura, prazo_vario;
+
     // Inicializa sistema
     inicializar_sistema();
 
+    prazo_leitura = RTC_Now();
+
     // Loop principal
     while(1) {
-        // Faz a leitura do sensor
-        ler_sensor();
+#if USE_DISPLAY
+        // Variômetro: pressão a 16Hz
+        if(VAR_Active() && SCH_Due(prazo_vario)) {
+            PERF_Start();
+            if(VAR_Sample())
+                UI_Refresh();
+            PERF_Save(PERF_VARIO, PERF_Elapsed());
+            SCH_Next(&prazo_vario, VAR_PERIODO);
+        }
+#endif
+        if(SCH_Due(prazo_leitura)) {
+            // Faz a leitura do sensor no período do nível adaptativo atual; em
+            // modo normal só logo após o fim de uma conversão (ADPT_Sync adia o
+            // prazo enquanto espera). O próximo prazo é calculado depois da
+            // amostra, que pode ter trocado o nível. Com o variômetro a leitura
+            // ambiental continua a cada VAR_AMBIENTE sobre os brutos dele
+            if(VAR_Active()) {
+                PIPE_Run();
+                SCH_Next(&prazo_leitura, VAR_AMBIENTE);
+            } else if(ADPT_Sync(&prazo_leitura)) {
+                PIPE_Run();
+                ADPT_Schedule(&prazo_leitura);
+            }
+        }
 
-        // Atualiza o display com a leitura atual
-        atualizar_display();
+#if USE_DISPLAY
+        // Botões e páginas do display (o LCD é atualizado em pedaços)
+        switch(UI_Task()) {
+            case UI_PEDE_AJUSTE:
+                executar_ajuste();
+                break;
 
-        // Aguarda 2 segundos antes da prxima atualizao
-        delay_ms(2000);
+            case UI_PEDE_GRAVAR:
+                ajustes.un_temp = un_temp;
+                ajustes.un_pres = un_pres;
+                ajustes.un_umid = un_umid;
+                AJS_Save();
+                break;
+        }
+#endif
+
+        // Comandos recebidos pela serial
+        if(CMD_Task() == CMD_PEDE_AJUSTE) {
+            executar_ajuste();
+            CMD_Report();                                                       // Devolve a configuração escolhida
+        }
+
+#if USE_DISPLAY
+        // A página Variômetro liga o modo de alta taxa; sair dela o desliga
+        if((UI_Page() == UI_VARIO) != VAR_Active()) {
+            if(VAR_Active()) {
+                VAR_Stop();
+                ADPT_Resync();                                                  // Fase do modo normal perdida
+                prazo_leitura = RTC_Now();                                      // Retoma com uma amostra imediata
+            } else {
+                VAR_Start();
+                prazo_vario = RTC_Now() + VAR_PERIODO;                          // Aguarda a primeira conversão
+            }
+        }
+#endif
+
+#if USE_USB_HID
+        // Atende o endpoint HID
+        HIDS_Task();
+#endif
+
+        // Sem pendências, dorme até o prazo da tarefa de leitura ativa (ou até
+        // o próximo passo da faixa rolante ou o apagamento do backlight); com o
+        // variômetro a leitura ambiental é atendida no passo de 16Hz seguinte
+        SCH_Idle(UI_Deadline(VAR_Active() ? prazo_vario : prazo_leitura));
     }
-}
\ No newline at end of file
+}
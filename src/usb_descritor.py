@@ -0,0 +1,158 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+###############################################################################
+# Ferramenta: Verificação do descritor de relatório HID (usb_descritor.py)
+# Autor: Elison Nogueira
+# Data: 18/10/2026
+# Versão: 1.0
+# Plataforma: PC (Python 3), não faz parte do firmware
+#
+# Descrição:
+# Lê o descritor de relatório de USBdsc.c e o confere com o que o firmware
+# monta em bibis/usb_sensor.c e bibis/usb_sensor.h:
+# - USB_HID_RPT_SIZE igual ao número de bytes do descritor
+# - Itens bem formados e coleções balanceadas (nenhum END_COLLECTION sobra
+#   ou falta)
+# - Report IDs do descritor iguais a HIDS_ID_*, cada um declarado uma vez
+# - Tamanho de cada relatório (bits de INPUT / 8 + o byte do ID) igual a
+#   HIDS_TAM_* e no máximo HID_INPUT_REPORT_BYTES
+# - Posição do valor e do timestamp em cada relatório igual aos índices
+#   escritos em usb_sensor.c, e o sinal do campo (LOGICAL_MINIMUM < 0) igual
+#   ao tipo escrito (temperatura com sinal; umidade, pressão e timestamp sem)
+#
+# Rode depois de mexer no descritor ou nos relatórios; sai com código 1 e a
+# lista das diferenças se algo não bate.
+#
+# Uso: python3 usb_descritor.py
+###############################################################################
+
+import os
+import re
+import sys
+
+PASTA = os.path.dirname(os.path.abspath(__file__))
+
+
+def le(nome):
+    with open(os.path.join(PASTA, nome), encoding='latin-1') as f:
+        return f.read()
+
+
+def sem_comentarios(texto):
+    texto = re.sub(r'/\*.*?\*/', '', texto, flags=re.S)
+    return re.sub(r'//[^\n]*', '', texto)
+
+
+dsc = sem_comentarios(le('USBdsc.c'))
+hdr = sem_comentarios(le(os.path.join('bibis', 'usb_sensor.h')))
+src = sem_comentarios(le(os.path.join('bibis', 'usb_sensor.c')))
+
+erros = []
+
+
+def confere(ok, msg):
+    if not ok:
+        erros.append(msg)
+
+
+def constante(texto, nome):
+    m = re.search(r'\b%s\s*=\s*(\w+)' % nome, texto)
+    return int(m.group(1), 0)
+
+
+def define(nome):
+    m = re.search(r'#define\s+%s\s+(\w+)' % nome, hdr)
+    return int(m.group(1), 0)
+
+
+# Bytes do descritor de relatório
+m = re.search(r'hid_rpt_desc\s*=\s*\{\s*\{(.*?)\}\s*\}', dsc, re.S)
+rpt = [int(b, 16) for b in re.findall(r'0x[0-9A-Fa-f]+', m.group(1))]
+confere(len(rpt) == constante(dsc, 'USB_HID_RPT_SIZE'),
+        'USB_HID_RPT_SIZE = %d, descritor tem %d bytes' % (constante(dsc, 'USB_HID_RPT_SIZE'), len(rpt)))
+
+
+# Percorre os itens curtos (HID 1.11, seção 6.2.2.2)
+def com_sinal(v, n):
+    return v - (1 << (8 * n)) if n and v >= 1 << (8 * n - 1) else v
+
+
+relatorios = {}                                                                 # ID -> lista de campos (bit inicial, bits, logical_min)
+ids_declarados = []
+glob = {'tam': 0, 'qtd': 0, 'id': 0, 'min': 0}
+nivel = 0
+i = 0
+while i < len(rpt):
+    prefixo = rpt[i]
+    n = (0, 1, 2, 4)[prefixo & 3]
+    if prefixo == 0xFE or i + 1 + n > len(rpt):
+        confere(False, 'item malformado no byte %d' % i)
+        break
+    dado = 0
+    for k in range(n):
+        dado |= rpt[i + 1 + k] << (8 * k)
+    tipo, tag = (prefixo >> 2) & 3, prefixo >> 4
+    if tipo == 1:                                                               # Global
+        if tag == 1:
+            glob['min'] = com_sinal(dado, n)
+        elif tag == 7:
+            glob['tam'] = dado
+        elif tag == 8:
+            glob['id'] = dado
+            ids_declarados.append(dado)
+            relatorios.setdefault(dado, [])
+        elif tag == 9:
+            glob['qtd'] = dado
+    elif tipo == 0:                                                             # Principal
+        if tag == 0xA:
+            nivel += 1
+        elif tag == 0xC:
+            nivel -= 1
+            confere(nivel >= 0, 'END_COLLECTION sem COLLECTION no byte %d' % i)
+        elif tag == 8:
+            campos = relatorios.setdefault(glob['id'], [])
+            inicio = sum(c[1] for c in campos)
+            campos.append((inicio, glob['tam'] * glob['qtd'], glob['min']))
+    i += 1 + n
+confere(nivel == 0, 'coleções desbalanceadas: %d abertas no fim' % nivel)
+
+# Report IDs
+sensores = [('TEMPERATURA', 'temp', True), ('UMIDADE', 'umid', False), ('PRESSAO', 'pres', False)]
+confere(len(ids_declarados) == len(set(ids_declarados)), 'Report ID repetido: %s' % ids_declarados)
+confere(0 not in relatorios, 'INPUT fora de um Report ID')
+confere(sorted(relatorios) == sorted(define('HIDS_ID_' + s) for s, _, _ in sensores),
+        'Report IDs do descritor %s diferem de HIDS_ID_*' % sorted(relatorios))
+
+# Relatórios: tamanho, posição e sinal do valor e do timestamp
+limite = constante(dsc, 'HID_INPUT_REPORT_BYTES')
+for nome, var, sinal in sensores:
+    campos = relatorios.get(define('HIDS_ID_' + nome), [])
+    bits = sum(c[1] for c in campos)
+    tam = define('HIDS_TAM_' + nome)
+    confere(bits % 8 == 0, '%s: %d bits não fecham bytes' % (nome, bits))
+    confere(bits // 8 + 1 == tam, '%s: descritor dá %d bytes, HIDS_TAM_%s = %d' % (nome, bits // 8 + 1, nome, tam))
+    confere(tam <= limite, '%s: %d bytes passam de HID_INPUT_REPORT_BYTES' % (nome, tam))
+    if len(campos) != 4:
+        confere(False, '%s: esperados estado, evento, valor e timestamp; há %d campos' % (nome, len(campos)))
+        continue
+    valor, ts = campos[2], campos[3]
+
+    m = re.search(r'hids_rpt_%s\[(\d+)\]\s*=\s*Lo\(' % var, src)
+    confere(m and int(m.group(1)) == valor[0] // 8 + 1,
+            '%s: valor no byte %d do relatório, usb_sensor.c escreve em %s' % (nome, valor[0] // 8 + 1, m and m.group(1)))
+    escritos = len(re.findall(r'hids_rpt_%s\[\d+\]\s*=\s*(?:Lo|Hi|Higher|Highest)\(' % var, src))
+    confere(escritos * 8 == valor[1], '%s: valor de %d bits, usb_sensor.c escreve %d bytes' % (nome, valor[1], escritos))
+    confere((valor[2] < 0) == sinal, '%s: sinal do valor não bate com o tipo escrito' % nome)
+
+    m = re.search(r'HIDS_PutTs\(hids_rpt_%s\s*\+\s*(\d+)' % var, src)
+    confere(m and int(m.group(1)) == ts[0] // 8 + 1,
+            '%s: timestamp no byte %d do relatório, usb_sensor.c escreve em %s' % (nome, ts[0] // 8 + 1, m and m.group(1)))
+    confere(ts[1] == 32, '%s: timestamp de %d bits' % (nome, ts[1]))
+    confere(ts[2] >= 0, '%s: timestamp declarado com sinal (o tick do RTC é unsigned long)' % nome)
+
+for e in erros:
+    print('ERRO: ' + e)
+if erros:
+    sys.exit(1)
+print('OK: %d bytes, Report IDs %s, tamanhos %s' % (
+    len(rpt), sorted(relatorios), [define('HIDS_TAM_' + s) for s, _, _ in sensores]))